@@ -0,0 +1,35 @@
+# Selects which eap-error checks are compiled into each module. See
+# error/include/error-levels.hpp for what each level checks.
+set(EAP_CORE_CHECK_LEVEL "" CACHE STRING
+    "eap-error check level of every module: ALWAYS, DEBUG or PARANOID. Empty \
+    selects DEBUG, or ALWAYS if the build type defines NDEBUG.")
+set_property(CACHE EAP_CORE_CHECK_LEVEL PROPERTY STRINGS "" ALWAYS DEBUG PARANOID)
+
+# eap_core_set_check_level(<TARGET> <MODULE>)
+#
+# Compiles the checks of module MODULE at the level in EAP_<MODULE>_CHECK_LEVEL,
+# which defaults to EAP_CORE_CHECK_LEVEL. The level is passed as the macro
+# EAP_<MODULE>_CHECK_LEVEL, which the module's sources and headers test with the
+# _IN forms of the eap-error macros. It is a PUBLIC definition, so that every
+# target including the module's headers compiles their inline code alike.
+function(eap_core_set_check_level TARGET MODULE)
+    set(EAP_${MODULE}_CHECK_LEVEL "${EAP_CORE_CHECK_LEVEL}" CACHE STRING
+        "eap-error check level of ${TARGET}: ALWAYS, DEBUG or PARANOID. \
+        Default: EAP_CORE_CHECK_LEVEL")
+    set_property(
+        CACHE EAP_${MODULE}_CHECK_LEVEL PROPERTY STRINGS "" ALWAYS DEBUG PARANOID)
+
+    set(LEVEL "${EAP_${MODULE}_CHECK_LEVEL}")
+    if (LEVEL STREQUAL "")
+        return()
+    endif()
+
+    if (NOT LEVEL MATCHES "^(ALWAYS|DEBUG|PARANOID)$")
+        message(FATAL_ERROR
+            "EAP_${MODULE}_CHECK_LEVEL must be ALWAYS, DEBUG or PARANOID, not \
+            '${LEVEL}'")
+    endif()
+
+    target_compile_definitions(
+        ${TARGET} PUBLIC EAP_${MODULE}_CHECK_LEVEL=EAP_ERROR_LEVEL_${LEVEL})
+endfunction()
@@ -10,6 +10,8 @@
 #ifndef EAP_COMM_FFI_TYPES_H_
 #define EAP_COMM_FFI_TYPES_H_
 
+#include <stdint.h>
+
 typedef enum _eap_comm_datatype_t {
     eap_comm_datatype_bool,
     eap_comm_datatype_int32,
@@ -30,4 +32,20 @@ typedef struct comm_token_t comm_token_t;
 typedef struct comm_token_builder_t comm_token_builder_t;
 typedef struct comm_rma_all_to_all_t comm_rma_all_to_all_t;
 
+/**
+ * @brief Communication volume of one or more exchanges. See eap::comm::CommVolume.
+ */
+typedef struct comm_volume_t {
+    uint64_t calls;
+    uint64_t messages_sent;
+    uint64_t messages_received;
+    uint64_t bytes_sent;
+    uint64_t bytes_received;
+    /** @brief Number of distinct ranks exchanged with, summed over calls. */
+    uint64_t neighbors;
+    uint64_t max_message_bytes;
+    /** @brief Number of batches the receives were split into, summed over calls. */
+    uint64_t receive_batches;
+} comm_volume_t;
+
 #endif // EAP_COMM_FFI_TYPES_H_
\ No newline at end of file
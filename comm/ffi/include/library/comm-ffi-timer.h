@@ -10,19 +10,96 @@
 #ifndef EAP_COMM_FFI_TIMER_H_
 #define EAP_COMM_FFI_TIMER_H_
 
+#include <stdbool.h>
+#include <stddef.h>
+
 #include <abi-extern.h>
 #include <perf-ffi-handles.h>
 
 EXTERN_C_BEGIN
 
 /**
- * @brief Gets a handle to the TimerRegistry used by eap::comm.
+ * @brief Gets a handle to the calling thread's TimerRegistry used by eap::comm.
  *
  * @return eap_perf_timer_registry_t
  *  FFI handle to the TimerRegistry
  */
 eap_perf_timer_registry_t *eap_comm_timer_registry();
 
+/**
+ * @brief Creates a TimerRegistry holding the eap::comm timers of every thread, merged by name.
+ *
+ * @details
+ *  eap_comm_timer_registry only returns the calling thread's timers. Must not be called while
+ *  other threads are inside eap::comm.
+ *
+ * @param registry
+ *  On return, the merged registry. Must be freed via eap_perf_timer_registry_free.
+ */
+void eap_comm_merged_timer_registry(eap_perf_timer_registry_t **registry);
+
+/**
+ * @brief Reduces the eap::comm timers across the world communicator and prints their statistics
+ *  to stdout on rank 0.
+ *
+ * @details
+ *  Collective. For each timer, prints the min, max, mean and standard deviation of the per-rank
+ *  times, the imbalance (max / mean), and the slowest rank.
+ *
+ * @param csv
+ *  Prints comma-separated values if true, otherwise an aligned table.
+ */
+void eap_comm_print_timer_statistics(bool csv);
+
+/**
+ * @brief Prints the communication volume of each eap::comm function on the calling rank, summed
+ *  over threads, to stdout.
+ *
+ * @details
+ *  Must not be called while other threads are inside eap::comm.
+ */
+void eap_comm_print_volumes();
+
+/**
+ * @brief Accumulates hardware counters (cycles, instructions, LLC and branch misses) over the
+ *  timed eap::comm sections of every thread. See eap_perf_timer_registry_enable_counters.
+ *
+ * @param available
+ *  Out parameter that is false if no counter can be read on the calling thread.
+ */
+void eap_comm_enable_counters(bool *available);
+
+/**
+ * @brief Prints the hardware counters of each eap::comm timer on the calling rank, summed over
+ *  threads, with the instructions per cycle and misses per 1000 instructions, to stdout.
+ *
+ * @details
+ *  Must not be called while other threads are inside eap::comm.
+ */
+void eap_comm_print_counters();
+
+/**
+ * @brief Records every timed eap::comm section on every thread into a ring buffer of `capacity`
+ *  events per thread. A capacity of 0 stops recording.
+ */
+void eap_comm_enable_tracing(size_t capacity);
+
+/**
+ * @brief Writes the events traced by the eap::comm timers as Chrome trace-event JSON.
+ *
+ * @details
+ *  Collective over the world communicator.
+ *
+ * @param prefix
+ *  Path of the output files without the ".json" extension. Doesn't need to end with a NULL.
+ * @param prefix_length
+ *  Number of characters in prefix
+ * @param merged
+ *  If true, rank 0 writes every rank's events to `<prefix>.json`. Otherwise each rank writes
+ *  `<prefix>.<rank>.json`.
+ */
+void eap_comm_write_trace(char const *prefix, size_t prefix_length, bool merged);
+
 EXTERN_C_END
 
 #endif // EAP_COMM_FFI_TIMER_H_
\ No newline at end of file
@@ -100,6 +100,9 @@ void comm_token_free(comm_token_t *token);
 void comm_token_get_home_num(comm_token_t const *token, size_t *home_num);
 void comm_token_get_home_size(comm_token_t const *token, size_t *home_size);
 
+void comm_token_get_volume(comm_token_t const *token, comm_volume_t *volume);
+void comm_token_reset_volume(comm_token_t *token);
+
 void comm_token_fill_home_arrays_f(comm_token_t const *token,
                                    size_t home_num,
                                    int *ranks,
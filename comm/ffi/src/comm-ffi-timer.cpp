@@ -1,6 +1,12 @@
 #include <comm-ffi-timer.h>
 
+#include <iostream>
+#include <string>
+
 #include <comm-timer.hpp>
+#include <comm-timer_reduce.hpp>
+#include <comm-trace.hpp>
+#include <comm-volume.hpp>
 #include <error-macros.hpp>
 #include <perf-ffi-interop.hpp>
 
@@ -10,5 +16,80 @@ eap_perf_timer_registry_t *eap_comm_timer_registry() {
 
     return eap::perf::ffi::TimerRegistryToFFI(eap::comm::GetTimerRegistry());
 
+    EAP_EXTERN_POST
+}
+
+EXTERN_C
+void eap_comm_merged_timer_registry(eap_perf_timer_registry_t **registry) {
+    EAP_EXTERN_PRE
+
+    *registry = eap::perf::ffi::TimerRegistryToFFI(
+        new eap::perf::ffi::TimerRegistryFFI(eap::comm::MergeTimerRegistries()));
+
+    EAP_EXTERN_POST
+}
+
+EXTERN_C
+void eap_comm_print_timer_statistics(bool csv) {
+    EAP_EXTERN_PRE
+
+    auto comm = mpi::Comm::world();
+    mpi::rank_t const root = 0;
+
+    auto const statistics = eap::comm::ReduceTimers(comm, root);
+    if (comm.rank() == root) {
+        eap::comm::PrintTimerStatistics(std::cout,
+                                        statistics,
+                                        csv ? eap::comm::TimerStatisticsFormat::Csv
+                                            : eap::comm::TimerStatisticsFormat::Table);
+    }
+
+    EAP_EXTERN_POST
+}
+
+EXTERN_C
+void eap_comm_print_volumes() {
+    EAP_EXTERN_PRE
+
+    eap::comm::PrintCommVolumes(std::cout, eap::comm::MergeCommVolumes());
+
+    EAP_EXTERN_POST
+}
+
+EXTERN_C
+void eap_comm_enable_counters(bool *available) {
+    EAP_EXTERN_PRE
+
+    *available = eap::comm::GetThreadedTimerRegistry()->EnableCounters();
+
+    EAP_EXTERN_POST
+}
+
+EXTERN_C
+void eap_comm_print_counters() {
+    EAP_EXTERN_PRE
+
+    eap::comm::MergeTimerRegistries().PrintCounters(std::cout);
+
+    EAP_EXTERN_POST
+}
+
+EXTERN_C
+void eap_comm_enable_tracing(size_t capacity) {
+    EAP_EXTERN_PRE
+
+    eap::comm::EnableTracing(capacity);
+
+    EAP_EXTERN_POST
+}
+
+EXTERN_C
+void eap_comm_write_trace(char const *prefix, size_t prefix_length, bool merged) {
+    EAP_EXTERN_PRE
+
+    auto const output =
+        merged ? eap::comm::TraceOutput::Merged : eap::comm::TraceOutput::PerRank;
+    eap::comm::WriteTrace(mpi::Comm::world(), std::string(prefix, prefix_length), output);
+
     EAP_EXTERN_POST
 }
\ No newline at end of file
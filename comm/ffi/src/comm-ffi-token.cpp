@@ -328,6 +328,29 @@ EXTERN_C void comm_token_get_home_size(comm_token_t const *token, size_t *home_s
     EAP_EXTERN_POST
 }
 
+EXTERN_C void comm_token_get_volume(comm_token_t const *token, comm_volume_t *volume) {
+    EAP_EXTERN_PRE
+
+    auto const &token_volume = (*TokenFromFFI(token))->GetVolume();
+
+    volume->calls = token_volume.calls;
+    volume->messages_sent = token_volume.messages_sent;
+    volume->messages_received = token_volume.messages_received;
+    volume->bytes_sent = token_volume.bytes_sent;
+    volume->bytes_received = token_volume.bytes_received;
+    volume->neighbors = token_volume.neighbors;
+    volume->max_message_bytes = token_volume.max_message_bytes;
+    volume->receive_batches = token_volume.receive_batches;
+
+    EAP_EXTERN_POST
+}
+
+EXTERN_C void comm_token_reset_volume(comm_token_t *token) {
+    EAP_EXTERN_PRE
+    (*TokenFromFFI(token))->ResetVolume();
+    EAP_EXTERN_POST
+}
+
 EXTERN_C void comm_token_fill_home_arrays_f(comm_token_t const *token,
                                             size_t home_num,
                                             int *ranks,
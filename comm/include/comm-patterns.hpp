@@ -97,6 +97,10 @@ class RmaAllToAll {
 
         barrier_.wait();
 
+        // Puts are one-sided, so this rank can't see what it receives
+        CommVolume volume;
+        volume.calls = 1;
+
         for (mpi::rank_t pe = 0; pe < comm_.size(); pe++) {
             bool all_zero = true;
             for (auto i = pe * count(); i < (pe + 1) * count(); i++) {
@@ -109,7 +113,9 @@ class RmaAllToAll {
             if (!all_zero) {
                 for (auto i = 0; i < count(); i++) {
                     win_.put(&send(pe * count() + i), 1, pe, comm_.rank() * count() + i);
+                    volume.RecordSend(sizeof(T));
                 }
+                volume.neighbors++;
             }
         }
 
@@ -126,6 +132,8 @@ class RmaAllToAll {
 
         barrier_ = comm_.immediate_barrier();
 
+        EAP_COMM_RECORD_VOLUME(volume);
+
         EE_DIAG_POST_MSG("send = [" << StringJoinView(send, ", ") << "], recv = ["
                                     << StringJoinView(recv, ", ") << "]")
     }
@@ -175,6 +183,9 @@ std::vector<T> SomeToSome(mpi::Comm &comm,
 
     std::vector<T> recv_array(comm.size());
 
+    CommVolume volume;
+    volume.calls = 1;
+
     {
         size_t const num_sends =
             std::count_if(to_pes.begin(), to_pes.end(), [](int b) { return b != 0; });
@@ -187,18 +198,27 @@ std::vector<T> SomeToSome(mpi::Comm &comm,
         for (mpi::rank_t rank = 0; rank < comm.size(); rank++) {
             if (from_pes[rank]) {
                 requests.push_back(comm.immediate_recv(recv_array[rank], rank, SOME_TO_SOME_TAG));
+                volume.RecordReceive(sizeof(T));
             }
         }
 
         for (mpi::rank_t rank = 0; rank < comm.size(); rank++) {
             if (to_pes[rank]) {
                 requests.push_back(comm.immediate_send(send_array[rank], rank, SOME_TO_SOME_TAG));
+                volume.RecordSend(sizeof(T));
+            }
+
+            if (to_pes[rank] || from_pes[rank]) {
+                volume.neighbors++;
             }
         }
+        volume.receive_batches = num_recvs > 0 ? 1 : 0;
 
         mpi::wait_all(requests);
     }
 
+    EAP_COMM_RECORD_VOLUME(volume);
+
     return recv_array;
 
     EE_DIAG_POST_MSG("send_array = [" << StringJoin(send_array, ", ") << "], to_pes = ["
@@ -276,19 +296,29 @@ void Move(mpi::Comm comm,
     std::vector<mpi::UniqueRequest> requests;
     requests.reserve(num_sends + num_recvs);
 
+    CommVolume volume;
+    volume.calls = 1;
+
     // Issue receives
     for (rank_t pe = 0; pe < comm.size(); pe++) {
         if (pe != my_pe && recv_length[pe] > 0) {
             requests.push_back(
                 comm.immediate_recv(&recv_data[recv_start[pe]], recv_length[pe], pe, MOVE_TAG));
+            volume.RecordReceive(recv_length[pe] * sizeof(T));
         }
     }
+    volume.receive_batches = volume.messages_received > 0 ? 1 : 0;
 
     // Issue sends
     for (rank_t pe = 0; pe < comm.size(); pe++) {
         if (pe != my_pe && send_length[pe] > 0) {
             requests.push_back(
                 comm.immediate_send(&send_data[send_start[pe]], send_length[pe], pe, MOVE_TAG));
+            volume.RecordSend(send_length[pe] * sizeof(T));
+        }
+
+        if (pe != my_pe && (send_length[pe] > 0 || recv_length[pe] > 0)) {
+            volume.neighbors++;
         }
     }
 
@@ -305,6 +335,8 @@ void Move(mpi::Comm comm,
     // Synchronize
     mpi::wait_all(requests);
 
+    EAP_COMM_RECORD_VOLUME(volume);
+
     EE_DIAG_POST_MSG("send_start = [" << StringJoin(send_start, ", ") << "], send_length = ["
                                       << StringJoin(send_length, ", ") << "], send_data = ["
                                       << StringJoin(send_data, ", ") << "], recv_start = ["
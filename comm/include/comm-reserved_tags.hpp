@@ -18,6 +18,8 @@ constexpr mpi::tag_t BUILD_GLOBAL_TAG = 1000;
 constexpr mpi::tag_t TOKEN_GS_TAG = 1001;
 constexpr mpi::tag_t SOME_TO_SOME_TAG = 1002;
 constexpr mpi::tag_t MOVE_TAG = 1003;
+constexpr mpi::tag_t REDUCE_TIMERS_TAG = 1004;
+constexpr mpi::tag_t WRITE_TRACE_TAG = 1005;
 } // namespace comm
 } // namespace eap
 
@@ -1,26 +1,69 @@
 #ifndef EAP_COMM_TIMER_HPP_
 #define EAP_COMM_TIMER_HPP_
 
+#include <string>
+
 #include <perf-registry.hpp>
+#include <perf-threaded_registry.hpp>
+
+#include "comm-volume.hpp"
 
 namespace eap {
 namespace comm {
 /**
  * @brief
- *  Returns the TimerRegistry used by eap::comm.
+ *  Returns the ThreadedTimerRegistry holding the per-thread timers of eap::comm.
+ *
+ * @return eap::perf::ThreadedTimerRegistry<> *
+ *  Pointer to the eap::comm ThreadedTimerRegistry. Never nullptr.
+ */
+eap::perf::ThreadedTimerRegistry<> *GetThreadedTimerRegistry();
+
+/**
+ * @brief
+ *  Returns the calling thread's TimerRegistry used by eap::comm.
+ *
+ * @details
+ *  Each thread records into its own registry without locking. Use MergeTimerRegistries to see the
+ *  timers of every thread.
  *
  * @return eap::perf::TimerRegistry<> *
- *  Pointer to the eap::comm TimerRegistry. Never nullptr.
+ *  Pointer to the calling thread's eap::comm TimerRegistry. Never nullptr.
  */
 eap::perf::TimerRegistry<> *GetTimerRegistry();
+
+/**
+ * @brief
+ *  Returns the eap::comm timers of every thread, merged by name.
+ *
+ * @details
+ *  Must not be called while other threads are inside eap::comm.
+ */
+eap::perf::TimerRegistry<> MergeTimerRegistries();
+
+namespace internal {
+/**
+ * @brief The calling thread's timer and volume counters for one EAP_COMM_TIME_FUNCTION site
+ */
+struct TimedSite {
+    eap::perf::TimerHandle timer;
+    CommVolume *volume;
+};
+
+TimedSite RegisterTimedSite(std::string const &name);
+} // namespace internal
 } // namespace comm
 } // namespace eap
 
+// The site is cached per-thread, since each thread has its own registry and counters
 #define EAP_COMM_TIME_FUNCTION(TimeNameExpression)                                                 \
-    static eap::perf::TimerHandle const eap_comm_timer_handle =                                    \
-        eap::comm::GetTimerRegistry()->InsertOrLookupTimer((TimeNameExpression));                  \
+    static thread_local eap::comm::internal::TimedSite const eap_comm_site =                       \
+        eap::comm::internal::RegisterTimedSite((TimeNameExpression));                              \
                                                                                                    \
     eap::perf::TimedSection<> const eap_comm_time_function =                                       \
-        eap::comm::GetTimerRegistry()->TimeSection(eap_comm_timer_handle);
+        eap::comm::GetTimerRegistry()->TimeSection(eap_comm_site.timer);
+
+// Adds the CommVolume `VolumeExpression` to the counters of the enclosing EAP_COMM_TIME_FUNCTION
+#define EAP_COMM_RECORD_VOLUME(VolumeExpression) (*eap_comm_site.volume += (VolumeExpression))
 
-#endif // EAP_COMM_TIMER_HPP_
\ No newline at end of file
+#endif // EAP_COMM_TIMER_HPP_
@@ -0,0 +1,95 @@
+/**
+ * @file comm-timer_reduce.hpp
+ *
+ * @brief Reduces TimerRegistry timers across the ranks of a communicator
+ * @date 2019-09-25
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef EAP_COMM_TIMER_REDUCE_HPP_
+#define EAP_COMM_TIMER_REDUCE_HPP_
+
+// STL includes
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// External includes
+#include <mpi/mpi.hpp>
+
+// Internal package includes
+#include <perf-registry.hpp>
+
+namespace eap {
+namespace comm {
+/**
+ * @brief Statistics of one timer across the ranks of a communicator.
+ *
+ * @details
+ *  Times are in seconds and describe the per-rank sum of the timer, SumTime(). Ranks that never
+ *  registered the timer count as having spent no time in it.
+ */
+struct TimerStatistics {
+    std::string name;
+
+    /// Number of ranks that registered the timer
+    int num_ranks = 0;
+    /// Total TimerCount over every rank
+    std::uint64_t count = 0;
+
+    double min = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+    /// Population standard deviation
+    double stddev = 0.0;
+
+    /// max / mean, or 1 if no time was spent at all. 1 is perfectly balanced.
+    double imbalance = 1.0;
+    /// Lowest rank that spent `max` in the timer
+    mpi::rank_t slowest_rank = 0;
+};
+
+/**
+ * @brief How PrintTimerStatistics formats its output
+ */
+enum class TimerStatisticsFormat {
+    /// Aligned, human-readable columns
+    Table,
+    /// Comma-separated values with a header row. Names are quoted.
+    Csv
+};
+
+/**
+ * @brief Gathers every timer of `registry` onto `root` and reduces it across ranks.
+ *
+ * @details
+ *  Collective over `comm`. Each rank may have registered a different set of timers; the result
+ *  holds every timer registered on any rank. Runs still in progress aren't included.
+ *
+ *  Costs two all-gathers of sizes, after which every other rank sends its timer names and sums to
+ *  `root`. Only `root` holds every rank's timers at once.
+ *
+ * @return std::vector<TimerStatistics>
+ *  On `root`, the statistics of each timer ordered by decreasing `max`, so the timers that limit
+ *  scaling come first. Empty on every other rank.
+ */
+std::vector<TimerStatistics>
+ReduceTimers(mpi::Comm comm, eap::perf::TimerRegistry<> const &registry, mpi::rank_t root = 0);
+
+/**
+ * @brief Reduces the eap::comm timers of every thread, see MergeTimerRegistries, across `comm`.
+ */
+std::vector<TimerStatistics> ReduceTimers(mpi::Comm comm, mpi::rank_t root = 0);
+
+/**
+ * @brief Writes `statistics` to `os` in the given format, one timer per row.
+ */
+void PrintTimerStatistics(std::ostream &os,
+                          std::vector<TimerStatistics> const &statistics,
+                          TimerStatisticsFormat format = TimerStatisticsFormat::Table);
+} // namespace comm
+} // namespace eap
+
+#endif // EAP_COMM_TIMER_REDUCE_HPP_
@@ -39,6 +39,14 @@
 #include "comm-reserved_tags.hpp"
 #include "comm-timer.hpp"
 
+/**
+ * @brief The eap-error check level of eap-comm, and of its headers wherever they are included.
+ * Defined by CMake for eap-comm and everything linking to it, see cmake/ErrorChecks.cmake.
+ */
+#ifndef EAP_COMM_CHECK_LEVEL
+#define EAP_COMM_CHECK_LEVEL EAP_ERROR_DEFAULT_CHECK_LEVEL
+#endif
+
 namespace eap {
 namespace comm {
 
@@ -136,6 +144,14 @@ class Token {
 
     size_t GetHomeSize() const { return home_index_.size(); }
 
+    /**
+     * @brief Returns the communication volume of every Get and Put through this Token since it was
+     *  built or ResetVolume was last called.
+     */
+    CommVolume const &GetVolume() const { return volume_; }
+
+    void ResetVolume() { volume_ = CommVolume(); }
+
     void FillHomeArrays(nonstd::span<mpi::rank_t> ranks,
                         nonstd::span<eap::utility::FortranIndex<local_index_t>> los,
                         nonstd::span<local_index_t> lengths,
@@ -203,8 +219,9 @@ class Token {
                      eap::HostMemorySpace>
             output_host = Convert1DTo2D(output);
 
-        GatherScatter<decltype(input_host), decltype(output_host), ValueType>(
-            DoWhich::Gather, dowhat, input_host, output_host);
+        EAP_COMM_RECORD_VOLUME(
+            (GatherScatter<decltype(input_host), decltype(output_host), ValueType>(
+                DoWhich::Gather, dowhat, input_host, output_host)));
 
         EE_DIAG_POST_MSG("dowhat = " << (int)dowhat)
     }
@@ -332,7 +349,7 @@ class Token {
                      eap::HostMemorySpace>
             output_host = output;
 
-        GatherScatter(DoWhich::Gather, dowhat, input_host, output_host);
+        EAP_COMM_RECORD_VOLUME(GatherScatter(DoWhich::Gather, dowhat, input_host, output_host));
 
         EE_DIAG_POST_MSG("dowhat = " << (int)dowhat)
     }
@@ -411,7 +428,7 @@ class Token {
                      eap::HostMemorySpace>
             output_host = Transpose(output);
 
-        GetV(dowhat, input_host, output_host);
+        EAP_COMM_RECORD_VOLUME(GatherScatter(DoWhich::Gather, dowhat, input_host, output_host));
 
         EE_DIAG_POST_MSG("dowhat = " << (int)dowhat)
     }
@@ -511,7 +528,7 @@ class Token {
                      eap::HostMemorySpace>
             output_host = Convert1DTo2D(output);
 
-        GatherScatter(DoWhich::Scatter, dowhat, input_host, output_host);
+        EAP_COMM_RECORD_VOLUME(GatherScatter(DoWhich::Scatter, dowhat, input_host, output_host));
 
         EE_DIAG_POST_MSG("dowhat = " << (int)dowhat)
     }
@@ -644,7 +661,7 @@ class Token {
                      eap::HostMemorySpace>
             output_host = output;
 
-        GatherScatter(DoWhich::Scatter, dowhat, input_host, output_host);
+        EAP_COMM_RECORD_VOLUME(GatherScatter(DoWhich::Scatter, dowhat, input_host, output_host));
 
         EE_DIAG_POST_MSG("dowhat = " << (int)dowhat)
     }
@@ -726,7 +743,7 @@ class Token {
                      eap::HostMemorySpace>
             output_host = Transpose(output);
 
-        PutV(dowhat, input_host, output_host);
+        EAP_COMM_RECORD_VOLUME(GatherScatter(DoWhich::Scatter, dowhat, input_host, output_host));
 
         EE_DIAG_POST_MSG("dowhat = " << (int)dowhat)
     }
@@ -777,6 +794,10 @@ class Token {
 
     bool require_rank_order_completion_ = false;
 
+    /// Number of distinct ranks in home_segments_ and away_segments_
+    std::size_t num_neighbors_ = 0;
+    CommVolume volume_;
+
     Token(mpi::Comm comm,
           std::size_t minimum_gather_size,
           std::size_t minimum_scatter_size,
@@ -878,13 +899,16 @@ class Token {
         return end;
     }
 
+    /**
+     * @brief Exchanges the data, returning the volume of the exchange after adding it to volume_
+     */
     template <typename InputView,
               typename OutputView,
               typename ValueType = typename OutputView::non_const_value_type>
-    void GatherScatter(DoWhich dowhich,
-                       TokenOperation dowhat,
-                       InputView const &input,
-                       OutputView &output) {
+    CommVolume GatherScatter(DoWhich dowhich,
+                             TokenOperation dowhat,
+                             InputView const &input,
+                             OutputView &output) {
         using namespace comm::internal;
 
         using Kokkos::ALL;
@@ -894,7 +918,8 @@ class Token {
 
         using OutputType = typename OutputView::non_const_value_type;
 
-        EE_DIAG_PRE
+        // Each Get and Put adds its own context, so the try block is only kept in debug builds
+        EE_DIAG_PRE_DEBUG_IN(EAP_COMM_CHECK_LEVEL)
 
         EE_ASSERT_EQ(input.extent(1),
                      output.extent(1),
@@ -903,8 +928,9 @@ class Token {
                                        << output.extent(1)
                                        << ")) must have the same number of columns");
 
-        EE_ASSERT(dowhich == DoWhich::Gather || dowhich == DoWhich::Scatter,
-                  "The value of dowhich (" << (int)dowhich << ") is invalid.");
+        EE_ASSERT_DEBUG_IN(EAP_COMM_CHECK_LEVEL,
+                           dowhich == DoWhich::Gather || dowhich == DoWhich::Scatter,
+                           "The value of dowhich (" << (int)dowhich << ") is invalid.");
 
         auto const row_size = input.extent(1);
 
@@ -939,6 +965,10 @@ class Token {
             }
         }
 
+        CommVolume volume;
+        volume.calls = 1;
+        volume.neighbors = num_neighbors_;
+
         vector<UniqueRequest> recv_requests;
 
         auto recv_batch_begin = recv_segments.begin();
@@ -953,6 +983,11 @@ class Token {
                     segment->length * row_size,
                     segment->rank,
                     TOKEN_GS_TAG));
+                volume.RecordReceive(segment->length * row_size * sizeof(ValueType));
+            }
+
+            if (recv_batch_begin != recv_batch_end) {
+                volume.receive_batches++;
             }
         };
 
@@ -972,6 +1007,7 @@ class Token {
                                          segment.length * row_size,
                                          segment.rank,
                                          TOKEN_GS_TAG));
+                volume.RecordSend(segment.length * row_size * sizeof(ValueType));
             }
         }
 
@@ -983,6 +1019,7 @@ class Token {
                                          segment.length * row_size,
                                          segment.rank,
                                          TOKEN_GS_TAG));
+                volume.RecordSend(segment.length * row_size * sizeof(ValueType));
             }
         }
 
@@ -1116,7 +1153,11 @@ class Token {
 
         mpi::wait_all(send_requests);
 
-        EE_DIAG_POST_MSG("dowhich = " << (int)dowhich << ", dowhat = " << (int)dowhat)
+        volume_ += volume;
+        return volume;
+
+        EE_DIAG_POST_MSG_DEBUG_IN(EAP_COMM_CHECK_LEVEL,
+                                  "dowhich = " << (int)dowhich << ", dowhat = " << (int)dowhat)
     }
 }; // namespace comm
 
@@ -1455,7 +1496,7 @@ class TokenBuilder {
 };
 
 #define TOKEN_INSTANTIATE_TOKEN_GS_UNIT(type)                                                      \
-    template void Token::GatherScatter<                                                            \
+    template CommVolume Token::GatherScatter<                                                      \
         Kokkos::View<type const * [1], Kokkos::LayoutRight, eap::HostMemorySpace>,                 \
         Kokkos::View<type * [1], Kokkos::LayoutRight, eap::HostMemorySpace>>(                      \
         DoWhich,                                                                                   \
@@ -1467,8 +1508,9 @@ extern TOKEN_INSTANTIATE_TOKEN_GS_UNIT(double);
 extern TOKEN_INSTANTIATE_TOKEN_GS_UNIT(float);
 
 #define TOKEN_INSTANTIATE_TOKEN_GS_V(type, layout)                                                 \
-    template void Token::GatherScatter<Kokkos::View<type const **, layout, eap::HostMemorySpace>,  \
-                                       Kokkos::View<type **, layout, eap::HostMemorySpace>>(       \
+    template CommVolume                                                                            \
+    Token::GatherScatter<Kokkos::View<type const **, layout, eap::HostMemorySpace>,                \
+                         Kokkos::View<type **, layout, eap::HostMemorySpace>>(                     \
         DoWhich,                                                                                   \
         TokenOperation,                                                                            \
         Kokkos::View<type const **, layout, eap::HostMemorySpace> const &,                         \
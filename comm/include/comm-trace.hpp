@@ -0,0 +1,67 @@
+/**
+ * @file comm-trace.hpp
+ *
+ * @brief Writes the timelines traced by the eap::comm timers of every rank
+ * @date 2019-09-26
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef EAP_COMM_TRACE_HPP_
+#define EAP_COMM_TRACE_HPP_
+
+// STL includes
+#include <cstddef>
+#include <string>
+
+// External includes
+#include <mpi/mpi.hpp>
+
+namespace eap {
+namespace comm {
+/**
+ * @brief Where WriteTrace writes each rank's events
+ */
+enum class TraceOutput {
+    /// Each rank writes `<prefix>.<rank>.json`
+    PerRank,
+    /// The root rank writes every rank's events to `<prefix>.json`
+    Merged
+};
+
+/**
+ * @brief Records every timed eap::comm section on every thread into a ring buffer of `capacity`
+ *  events per thread. A capacity of 0 stops recording.
+ *
+ * @details
+ *  Local. Must not be called while other threads are inside eap::comm. See
+ *  eap::perf::TimerRegistry::EnableTracing.
+ */
+void EnableTracing(std::size_t capacity);
+
+/**
+ * @brief Writes the events traced by the eap::comm timers as Chrome trace-event JSON, viewable with
+ *  chrome://tracing or https://ui.perfetto.dev.
+ *
+ * @details
+ *  Collective over `comm`. Each rank appears as a process numbered by its rank in `comm`, and each
+ *  thread as a thread of that process. Timestamps come from each rank's clock, so they only line
+ *  up across ranks on the same node.
+ *
+ *  With TraceOutput::Merged, every other rank sends its events to `root`, which writes the file.
+ *
+ * @param comm Communicator whose ranks write their events
+ * @param prefix Path of the output files, without the ".json" extension
+ * @param output Whether to write a file per rank or a single file
+ * @param root Rank that writes the file for TraceOutput::Merged
+ * @throws std::runtime_error if a file can't be opened. With TraceOutput::Merged, every rank
+ *  throws.
+ */
+void WriteTrace(mpi::Comm comm,
+                std::string const &prefix,
+                TraceOutput output = TraceOutput::PerRank,
+                mpi::rank_t root = 0);
+} // namespace comm
+} // namespace eap
+
+#endif // EAP_COMM_TRACE_HPP_
@@ -0,0 +1,102 @@
+/**
+ * @file comm-volume.hpp
+ *
+ * @brief Counts the messages and bytes exchanged by eap::comm communication patterns
+ * @date 2019-09-28
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef EAP_COMM_VOLUME_HPP_
+#define EAP_COMM_VOLUME_HPP_
+
+// STL includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+
+namespace eap {
+namespace comm {
+/**
+ * @brief Communication volume of one or more calls to a communication pattern.
+ *
+ * @details
+ *  Together with the timer of the same name, tells latency-bound exchanges (many small messages,
+ *  many neighbors) from bandwidth-bound ones (few large messages). Data a pattern copies locally,
+ *  rather than sending to its own rank, isn't counted. RmaAllToAll puts are one-sided, so only
+ *  the sending rank counts them.
+ */
+struct CommVolume {
+    /// Number of calls counted
+    std::uint64_t calls = 0;
+
+    std::uint64_t messages_sent = 0;
+    std::uint64_t messages_received = 0;
+    std::uint64_t bytes_sent = 0;
+    std::uint64_t bytes_received = 0;
+
+    /// Number of distinct ranks sent to or received from, summed over calls
+    std::uint64_t neighbors = 0;
+    /// Size of the largest message sent or received
+    std::uint64_t max_message_bytes = 0;
+    /// Number of batches the receives were split into, summed over calls. See
+    /// TokenBuilder::SetMaxGsReceiveSize.
+    std::uint64_t receive_batches = 0;
+
+    void RecordSend(std::size_t bytes) noexcept {
+        messages_sent++;
+        bytes_sent += bytes;
+        max_message_bytes = std::max<std::uint64_t>(max_message_bytes, bytes);
+    }
+
+    void RecordReceive(std::size_t bytes) noexcept {
+        messages_received++;
+        bytes_received += bytes;
+        max_message_bytes = std::max<std::uint64_t>(max_message_bytes, bytes);
+    }
+
+    CommVolume &operator+=(CommVolume const &other) noexcept {
+        calls += other.calls;
+        messages_sent += other.messages_sent;
+        messages_received += other.messages_received;
+        bytes_sent += other.bytes_sent;
+        bytes_received += other.bytes_received;
+        neighbors += other.neighbors;
+        max_message_bytes = std::max(max_message_bytes, other.max_message_bytes);
+        receive_batches += other.receive_batches;
+        return *this;
+    }
+};
+
+/**
+ * @brief
+ *  Returns the calling thread's volume counters for the eap::comm function timed as `name`.
+ *
+ * @details
+ *  The counters are only ever touched by the calling thread, so recording into them never locks.
+ *  The returned pointer stays valid for the life of the program. Never nullptr.
+ */
+CommVolume *GetCommVolume(std::string const &name);
+
+/**
+ * @brief
+ *  Returns the volume counters of every eap::comm function, summed over threads and keyed by the
+ *  name of the function's timer. Functions that haven't recorded a call are left out.
+ *
+ * @details
+ *  Must not be called while other threads are inside eap::comm.
+ */
+std::map<std::string, CommVolume> MergeCommVolumes();
+
+/**
+ * @brief Writes `volumes` to `os` as an aligned table, one function per row, with the average
+ *  message size and number of neighbors per call.
+ */
+void PrintCommVolumes(std::ostream &os, std::map<std::string, CommVolume> const &volumes);
+} // namespace comm
+} // namespace eap
+
+#endif // EAP_COMM_VOLUME_HPP_
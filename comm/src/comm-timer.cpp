@@ -1,6 +1,19 @@
 #include <comm-timer.hpp>
 
-eap::perf::TimerRegistry<> *eap::comm::GetTimerRegistry() {
-    static eap::perf::TimerRegistry<> *global_timer_registry = new eap::perf::TimerRegistry<>();
+eap::perf::ThreadedTimerRegistry<> *eap::comm::GetThreadedTimerRegistry() {
+    static eap::perf::ThreadedTimerRegistry<> *global_timer_registry =
+        new eap::perf::ThreadedTimerRegistry<>();
     return global_timer_registry;
-}
\ No newline at end of file
+}
+
+eap::perf::TimerRegistry<> *eap::comm::GetTimerRegistry() {
+    return &GetThreadedTimerRegistry()->Local();
+}
+
+eap::perf::TimerRegistry<> eap::comm::MergeTimerRegistries() {
+    return GetThreadedTimerRegistry()->Merged();
+}
+
+eap::comm::internal::TimedSite eap::comm::internal::RegisterTimedSite(std::string const &name) {
+    return TimedSite{GetTimerRegistry()->InsertOrLookupTimer(name), GetCommVolume(name)};
+}
@@ -0,0 +1,211 @@
+/**
+ * @file comm-timer_reduce.cpp
+ *
+ * @brief Implements the reduction of TimerRegistry timers across ranks
+ * @date 2019-09-25
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+// Matching header include
+#include <comm-timer_reduce.hpp>
+
+// STL Includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+#include <unordered_map>
+#include <utility>
+
+// Package includes
+#include "comm-reserved_tags.hpp"
+#include "comm-timer.hpp"
+
+using namespace eap;
+using namespace eap::comm;
+
+namespace {
+/// Values sent for each timer: the sum in seconds and the number of runs
+constexpr std::size_t VALUES_PER_TIMER = 2;
+
+/**
+ * @brief Writes `name` as a CSV field, doubling any embedded quotes
+ */
+void WriteCsvName(std::ostream &os, std::string const &name) {
+    os << '"';
+    for (auto const c : name) {
+        if (c == '"') os << '"';
+        os << c;
+    }
+    os << '"';
+}
+} // namespace
+
+std::vector<TimerStatistics> eap::comm::ReduceTimers(mpi::Comm comm,
+                                                     eap::perf::TimerRegistry<> const &registry,
+                                                     mpi::rank_t const root) {
+    using seconds = std::chrono::duration<double>;
+
+    auto const num_ranks = static_cast<std::size_t>(comm.size());
+    bool const is_root = comm.rank() == root;
+
+    // Pack this rank's timers as NUL-separated names and (sum, count) pairs
+    std::string names;
+    std::vector<double> values;
+    for (auto const handle : registry.Timers()) {
+        auto const name = registry.GetTimerName(handle);
+        auto const &timer = registry.GetTimer(handle);
+
+        names.append(name.data(), name.size());
+        names.push_back('\0');
+
+        values.push_back(std::chrono::duration_cast<seconds>(timer.SumTime()).count());
+        values.push_back(static_cast<double>(timer.TimerCount()));
+    }
+
+    // The root receives every rank's timers, so it needs their sizes first
+    auto const all_num_timers = comm.all_gather(static_cast<std::uint64_t>(registry.Count()));
+    auto const all_names_size = comm.all_gather(static_cast<std::uint64_t>(names.size()));
+
+    if (!is_root) {
+        std::vector<mpi::UniqueRequest> requests;
+        requests.push_back(
+            comm.immediate_send(names.data(), names.size(), root, REDUCE_TIMERS_TAG));
+        requests.push_back(
+            comm.immediate_send(values.data(), values.size(), root, REDUCE_TIMERS_TAG));
+        mpi::wait_all(requests);
+
+        return {};
+    }
+
+    std::vector<std::string> all_names(num_ranks);
+    std::vector<std::vector<double>> all_values(num_ranks);
+    std::vector<mpi::UniqueRequest> requests;
+    for (std::size_t rank = 0; rank < num_ranks; rank++) {
+        if (rank == static_cast<std::size_t>(root)) {
+            all_names[rank] = std::move(names);
+            all_values[rank] = std::move(values);
+            continue;
+        }
+
+        all_names[rank].resize(all_names_size[rank]);
+        all_values[rank].resize(all_num_timers[rank] * VALUES_PER_TIMER);
+
+        // Messages from one rank arrive in order, so the names are always received first
+        requests.push_back(comm.immediate_recv(&all_names[rank][0],
+                                               all_names[rank].size(),
+                                               static_cast<mpi::rank_t>(rank),
+                                               REDUCE_TIMERS_TAG));
+        requests.push_back(comm.immediate_recv(all_values[rank].data(),
+                                               all_values[rank].size(),
+                                               static_cast<mpi::rank_t>(rank),
+                                               REDUCE_TIMERS_TAG));
+    }
+    mpi::wait_all(requests);
+
+    // Match timers by name, in order of first appearance, with each rank's sum
+    std::vector<TimerStatistics> statistics;
+    std::vector<std::vector<double>> sums;
+    std::unordered_map<std::string, std::size_t> index_of;
+
+    for (std::size_t rank = 0; rank < num_ranks; rank++) {
+        auto const *name = all_names[rank].data();
+        auto const *rank_values = all_values[rank].data();
+
+        for (std::size_t t = 0; t < all_num_timers[rank]; t++) {
+            std::string timer_name(name);
+            name += timer_name.size() + 1;
+
+            auto const inserted = index_of.emplace(std::move(timer_name), statistics.size());
+            if (inserted.second) {
+                statistics.emplace_back();
+                statistics.back().name = inserted.first->first;
+                sums.emplace_back(num_ranks, 0.0);
+            }
+
+            auto const i = inserted.first->second;
+            statistics[i].num_ranks++;
+            statistics[i].count +=
+                static_cast<std::uint64_t>(rank_values[t * VALUES_PER_TIMER + 1]);
+            sums[i][rank] = rank_values[t * VALUES_PER_TIMER];
+        }
+    }
+
+    for (std::size_t i = 0; i < statistics.size(); i++) {
+        auto &timer = statistics[i];
+        auto const &rank_sums = sums[i];
+
+        auto const minmax = std::minmax_element(rank_sums.begin(), rank_sums.end());
+        timer.min = *minmax.first;
+        timer.max = *minmax.second;
+        timer.slowest_rank = static_cast<mpi::rank_t>(
+            std::find(rank_sums.begin(), rank_sums.end(), timer.max) - rank_sums.begin());
+
+        double total = 0.0;
+        for (auto const sum : rank_sums) {
+            total += sum;
+        }
+        timer.mean = total / num_ranks;
+
+        double variance = 0.0;
+        for (auto const sum : rank_sums) {
+            variance += (sum - timer.mean) * (sum - timer.mean);
+        }
+        timer.stddev = std::sqrt(variance / num_ranks);
+
+        timer.imbalance = timer.mean > 0.0 ? timer.max / timer.mean : 1.0;
+    }
+
+    std::stable_sort(statistics.begin(), statistics.end(), [](auto const &a, auto const &b) {
+        return a.max > b.max;
+    });
+
+    return statistics;
+}
+
+std::vector<TimerStatistics> eap::comm::ReduceTimers(mpi::Comm comm, mpi::rank_t const root) {
+    auto const merged = MergeTimerRegistries();
+    return ReduceTimers(comm, merged, root);
+}
+
+void eap::comm::PrintTimerStatistics(std::ostream &os,
+                                     std::vector<TimerStatistics> const &statistics,
+                                     TimerStatisticsFormat const format) {
+    if (format == TimerStatisticsFormat::Csv) {
+        os << "name,ranks,count,min,max,mean,stddev,imbalance,slowest_rank\n";
+        for (auto const &timer : statistics) {
+            WriteCsvName(os, timer.name);
+            os << ',' << timer.num_ranks << ',' << timer.count << ',' << timer.min << ','
+               << timer.max << ',' << timer.mean << ',' << timer.stddev << ',' << timer.imbalance
+               << ',' << timer.slowest_rank << '\n';
+        }
+        return;
+    }
+
+    std::size_t name_width = 5;
+    for (auto const &timer : statistics) {
+        name_width = std::max(name_width, timer.name.size());
+    }
+
+    auto const flags = os.flags();
+    auto const precision = os.precision();
+
+    os << std::left << std::setw(name_width) << "timer" << std::right << std::setw(7) << "ranks"
+       << std::setw(12) << "count" << std::setw(12) << "min [s]" << std::setw(12) << "max [s]"
+       << std::setw(12) << "mean [s]" << std::setw(12) << "stddev [s]" << std::setw(11)
+       << "imbalance" << std::setw(9) << "slowest" << '\n';
+
+    os << std::fixed << std::setprecision(6);
+    for (auto const &timer : statistics) {
+        os << std::left << std::setw(name_width) << timer.name << std::right << std::setw(7)
+           << timer.num_ranks << std::setw(12) << timer.count << std::setw(12) << timer.min
+           << std::setw(12) << timer.max << std::setw(12) << timer.mean << std::setw(12)
+           << timer.stddev << std::setw(11) << std::setprecision(3) << timer.imbalance
+           << std::setprecision(6) << std::setw(9) << timer.slowest_rank << '\n';
+    }
+
+    os.flags(flags);
+    os.precision(precision);
+}
@@ -78,6 +78,31 @@ AwayCountAndSize NumAwayAndSize(rank_t mype, vector<int32_t> const &counts) {
 
     return AwayCountAndSize{count, size};
 }
+
+/**
+ * @brief Counts the distinct ranks of two lists of segments, each ordered by rank
+ */
+size_t NumNeighbors(vector<internal::Segment> const &home_segments,
+                    vector<internal::Segment> const &away_segments) {
+    size_t count = 0;
+
+    auto home = home_segments.begin();
+    auto away = away_segments.begin();
+    while (home != home_segments.end() && away != away_segments.end()) {
+        if (home->rank < away->rank) {
+            home++;
+        } else if (away->rank < home->rank) {
+            away++;
+        } else {
+            home++;
+            away++;
+        }
+        count++;
+    }
+
+    return count + static_cast<size_t>(home_segments.end() - home) +
+           static_cast<size_t>(away_segments.end() - away);
+}
 } // namespace
 
 void internal::BuildGlobalBase(mpi::Comm comm,
@@ -434,19 +459,28 @@ Token TokenBuilder::BuildLocal(span<FortranLocalIndex const> home_addresses,
                  "Could not allocate requests with "
                      << (home_segments.size() + away_segments.size()) << " Requests");
 
+        CommVolume volume;
+        volume.calls = 1;
+        volume.neighbors = NumNeighbors(home_segments, away_segments);
+
         for (auto &segment : home_segments) {
             assert(segment.rank != mype);
             requests.push_back(comm_.immediate_send(
                 &global_index[segment.begin], segment.length, segment.rank, BUILD_GLOBAL_TAG));
+            volume.RecordSend(segment.length * sizeof(local_index_t));
         }
 
         for (auto &segment : away_segments) {
             assert(segment.rank != mype);
             requests.push_back(comm_.immediate_recv(
                 &away_index[segment.begin], segment.length, segment.rank, BUILD_GLOBAL_TAG));
+            volume.RecordReceive(segment.length * sizeof(local_index_t));
         }
+        volume.receive_batches = away_segments.empty() ? 0 : 1;
 
         mpi::wait_all(requests);
+
+        EAP_COMM_RECORD_VOLUME(volume);
     }
 
     auto const max_home_addr = std::max_element(home_addresses.begin(), home_addresses.end());
@@ -510,7 +544,8 @@ Token::Token(mpi::Comm comm,
       away_index_(move(away_index)),
       has_target_max_gs_receive_size_(has_target_max_gs_receive_size),
       target_max_gs_receive_size_(target_max_gs_receive_size),
-      require_rank_order_completion_(require_rank_order_completion) {}
+      require_rank_order_completion_(require_rank_order_completion),
+      num_neighbors_(NumNeighbors(home_segments_, away_segments_)) {}
 
 void Token::FillHomeArrays(nonstd::span<mpi::rank_t> ranks,
                            nonstd::span<eap::utility::FortranIndex<local_index_t>> los,
@@ -0,0 +1,120 @@
+/**
+ * @file comm-trace.cpp
+ *
+ * @brief Implements writing the eap::comm traces of every rank
+ * @date 2019-09-26
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+// Matching header include
+#include <comm-trace.hpp>
+
+// STL Includes
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+// Internal package includes
+#include <perf-chrome_trace.hpp>
+
+// Package includes
+#include "comm-reserved_tags.hpp"
+#include "comm-timer.hpp"
+
+using namespace eap;
+using namespace eap::comm;
+
+namespace {
+/**
+ * @brief Returns the error thrown when `path` can't be opened for writing
+ */
+std::runtime_error OpenTraceFileError(std::string const &path) {
+    return std::runtime_error("eap::comm::WriteTrace: Could not open '" + path + "' for writing");
+}
+
+/**
+ * @brief Opens `path` for writing, throwing if it can't be opened
+ */
+std::ofstream OpenTraceFile(std::string const &path) {
+    std::ofstream file(path);
+    if (!file) {
+        throw OpenTraceFileError(path);
+    }
+    return file;
+}
+} // namespace
+
+void eap::comm::EnableTracing(std::size_t const capacity) {
+    GetThreadedTimerRegistry()->EnableTracing(capacity);
+}
+
+void eap::comm::WriteTrace(mpi::Comm comm,
+                           std::string const &prefix,
+                           TraceOutput const output,
+                           mpi::rank_t const root) {
+    auto const merged = MergeTimerRegistries();
+
+    if (output == TraceOutput::PerRank) {
+        auto file = OpenTraceFile(prefix + "." + std::to_string(comm.rank()) + ".json");
+        eap::perf::WriteChromeTrace(file, merged, comm.rank());
+        return;
+    }
+
+    // Open the file before any rank sends its events, so that if it can't be opened every rank
+    // throws instead of waiting on a root that has given up
+    auto const path = prefix + ".json";
+    std::ofstream file;
+    if (comm.rank() == root) {
+        file.open(path);
+    }
+    if (comm.all_reduce(mpi::max(), static_cast<int>(comm.rank() == root && !file))) {
+        throw OpenTraceFileError(path);
+    }
+
+    std::stringstream events;
+    eap::perf::WriteChromeTraceEvents(events, merged, comm.rank());
+    auto const local_events = events.str();
+
+    auto const num_overwritten = comm.all_reduce(
+        mpi::sum(), static_cast<std::uint64_t>(merged.GetTrace().NumOverwritten()));
+    auto const all_events_size = comm.all_gather(static_cast<std::uint64_t>(local_events.size()));
+
+    if (comm.rank() != root) {
+        if (!local_events.empty()) {
+            comm.immediate_send(local_events.data(), local_events.size(), root, WRITE_TRACE_TAG)
+                .wait();
+        }
+        return;
+    }
+
+    file << "{\"traceEvents\":[\n";
+
+    bool first = true;
+    std::string rank_events;
+    for (mpi::rank_t rank = 0; rank < comm.size(); rank++) {
+        if (all_events_size[rank] == 0) {
+            continue;
+        }
+
+        // Receive one rank at a time, so the root never holds more than one rank's events
+        if (rank == root) {
+            rank_events = local_events;
+        } else {
+            rank_events.resize(all_events_size[rank]);
+            comm.immediate_recv(&rank_events[0], rank_events.size(), rank, WRITE_TRACE_TAG)
+                .wait();
+        }
+
+        if (!first) {
+            file << ",\n";
+        }
+        file << rank_events;
+        first = false;
+    }
+
+    file << "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"overwritten_events\":"
+         << num_overwritten << "}}\n";
+}
@@ -0,0 +1,112 @@
+/**
+ * @file comm-volume.cpp
+ *
+ * @brief Implements the per-thread eap::comm communication volume counters
+ * @date 2019-09-28
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+// Matching header include
+#include <comm-volume.hpp>
+
+// STL Includes
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+using namespace eap::comm;
+
+namespace {
+using VolumeMap = std::unordered_map<std::string, CommVolume>;
+
+/**
+ * @brief The counters of every thread that has recorded into eap::comm
+ */
+struct ThreadVolumes {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<VolumeMap>> maps;
+};
+
+ThreadVolumes &GetThreadVolumes() {
+    static ThreadVolumes *thread_volumes = new ThreadVolumes();
+    return *thread_volumes;
+}
+
+/**
+ * @brief Returns the calling thread's counters, registering them on the thread's first call
+ */
+VolumeMap &LocalVolumes() {
+    thread_local VolumeMap *const local = [] {
+        auto &thread_volumes = GetThreadVolumes();
+        std::lock_guard<std::mutex> lock(thread_volumes.mutex);
+
+        thread_volumes.maps.push_back(std::make_unique<VolumeMap>());
+        return thread_volumes.maps.back().get();
+    }();
+
+    return *local;
+}
+} // namespace
+
+CommVolume *eap::comm::GetCommVolume(std::string const &name) {
+    // unordered_map never moves its elements, so the pointer outlives later insertions
+    return &LocalVolumes()[name];
+}
+
+std::map<std::string, CommVolume> eap::comm::MergeCommVolumes() {
+    auto &thread_volumes = GetThreadVolumes();
+    std::lock_guard<std::mutex> lock(thread_volumes.mutex);
+
+    std::map<std::string, CommVolume> merged;
+    for (auto const &map : thread_volumes.maps) {
+        for (auto const &entry : *map) {
+            if (entry.second.calls > 0) {
+                merged[entry.first] += entry.second;
+            }
+        }
+    }
+
+    return merged;
+}
+
+void eap::comm::PrintCommVolumes(std::ostream &os,
+                                 std::map<std::string, CommVolume> const &volumes) {
+    std::size_t name_width = 8;
+    for (auto const &entry : volumes) {
+        name_width = std::max(name_width, entry.first.size());
+    }
+
+    auto const flags = os.flags();
+    auto const precision = os.precision();
+
+    os << std::left << std::setw(name_width) << "function" << std::right << std::setw(10)
+       << "calls" << std::setw(12) << "msgs sent" << std::setw(12) << "msgs recv" << std::setw(14)
+       << "bytes sent" << std::setw(14) << "bytes recv" << std::setw(12) << "avg msg [B]"
+       << std::setw(12) << "max msg [B]" << std::setw(10) << "avg nbrs" << std::setw(10)
+       << "batches" << '\n';
+
+    os << std::fixed << std::setprecision(1);
+    for (auto const &entry : volumes) {
+        auto const &volume = entry.second;
+
+        auto const messages = volume.messages_sent + volume.messages_received;
+        auto const bytes = volume.bytes_sent + volume.bytes_received;
+        double const average_message = messages > 0 ? static_cast<double>(bytes) / messages : 0.0;
+        double const average_neighbors =
+            volume.calls > 0 ? static_cast<double>(volume.neighbors) / volume.calls : 0.0;
+
+        os << std::left << std::setw(name_width) << entry.first << std::right << std::setw(10)
+           << volume.calls << std::setw(12) << volume.messages_sent << std::setw(12)
+           << volume.messages_received << std::setw(14) << volume.bytes_sent << std::setw(14)
+           << volume.bytes_received << std::setw(12) << average_message << std::setw(12)
+           << volume.max_message_bytes << std::setw(10) << average_neighbors << std::setw(10)
+           << volume.receive_batches << '\n';
+    }
+
+    os.flags(flags);
+    os.precision(precision);
+}
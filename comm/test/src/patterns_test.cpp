@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include <comm-patterns.hpp>
+#include <comm-volume.hpp>
 
 using mpi::Comm;
 using mpi::rank_t;
@@ -58,6 +59,9 @@ TEST(Patterns, MoveSimple) {
         }
     }
 
+    auto const move_volume = [] { return eap::comm::MergeCommVolumes()["eap::comm::Move"]; };
+    auto const before = move_volume();
+
     Move(comm.deref(),
          span<FortranLocalIndex>(send_start),
          span<local_index_t>(send_length),
@@ -68,4 +72,17 @@ TEST(Patterns, MoveSimple) {
 
     std::vector<local_index_t> expected_recv(comm.rank() + 1, comm.rank());
     ASSERT_EQ(expected_recv, recv_data);
+
+    // Rank 0 copies its own slice locally, so it only messages the other ranks
+    auto const after = move_volume();
+    EXPECT_EQ(before.calls + 1, after.calls);
+    if (comm.rank() == 0) {
+        EXPECT_EQ(before.messages_sent + comm.size() - 1, after.messages_sent);
+        EXPECT_EQ(before.neighbors + comm.size() - 1, after.neighbors);
+    } else {
+        EXPECT_EQ(before.messages_received + 1, after.messages_received);
+        EXPECT_EQ(before.bytes_received + (comm.rank() + 1) * sizeof(local_index_t),
+                  after.bytes_received);
+        EXPECT_EQ(before.neighbors + 1, after.neighbors);
+    }
 }
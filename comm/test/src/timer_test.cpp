@@ -1,6 +1,19 @@
+#include <comm-timer.hpp>
+#include <comm-timer_reduce.hpp>
+#include <comm-trace.hpp>
 #include <comm-token.hpp>
+#include <comm-volume.hpp>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
 using eap::FortranLocalIndex;
 using eap::OptionalFortranGlobalIndex;
 using eap::OptionalFortranLocalIndex;
@@ -52,4 +65,161 @@ TEST(Timer, CheckTimer) {
 
         ASSERT_EQ(1, timer.TimerCount());
     }
-}
\ No newline at end of file
+
+    // Only this thread has timed anything, so merging changes nothing
+    auto merged = eap::comm::MergeTimerRegistries();
+    for (auto const expected : expected_timers) {
+        ASSERT_EQ(1, merged.GetTimer(merged.InsertOrLookupTimer(expected)).TimerCount());
+    }
+
+    // The transposed exchanges record their volume under their own timers
+    auto const volumes = eap::comm::MergeCommVolumes();
+    for (auto const name :
+         {"eap::comm::Token::GetVInv<std::int64_t>", "eap::comm::Token::PutVInv<char>"}) {
+        auto const found = volumes.find(name);
+        ASSERT_NE(volumes.end(), found);
+        ASSERT_EQ(1u, found->second.calls);
+    }
+}
+
+TEST(Timer, ReduceTimers) {
+    using namespace std::chrono_literals;
+
+    auto comm = mpi::Comm::world().dup();
+    auto const last_rank = comm.size() - 1;
+
+    // Each rank registers a different set of timers, and later ranks are slower
+    eap::perf::TimerRegistry<> registry;
+    {
+        auto const section = registry.TimeSection("all ranks");
+        std::this_thread::sleep_for((comm.rank() + 1) * 20ms);
+    }
+    if (comm.rank() == last_rank) {
+        auto const section = registry.TimeSection("last rank");
+    }
+    registry.InsertOrLookupTimer("rank " + std::to_string(comm.rank()));
+
+    auto const statistics = eap::comm::ReduceTimers(comm.deref(), registry);
+
+    if (comm.rank() != 0) {
+        ASSERT_TRUE(statistics.empty());
+        return;
+    }
+
+    ASSERT_EQ(static_cast<size_t>(comm.size()) + 2, statistics.size());
+
+    auto const find = [&](std::string const &name) {
+        return *std::find_if(statistics.begin(), statistics.end(), [&](auto const &timer) {
+            return timer.name == name;
+        });
+    };
+
+    // Slowest first
+    ASSERT_EQ("all ranks", statistics[0].name);
+
+    auto const all_ranks = find("all ranks");
+    ASSERT_EQ(comm.size(), all_ranks.num_ranks);
+    ASSERT_EQ(static_cast<std::uint64_t>(comm.size()), all_ranks.count);
+    ASSERT_EQ(last_rank, all_ranks.slowest_rank);
+    ASSERT_LE(all_ranks.min, all_ranks.mean);
+    ASSERT_LE(all_ranks.mean, all_ranks.max);
+    ASSERT_GE(all_ranks.imbalance, 1.0);
+
+    auto const last = find("last rank");
+    ASSERT_EQ(1, last.num_ranks);
+    ASSERT_EQ(1u, last.count);
+    ASSERT_EQ(last_rank, last.slowest_rank);
+
+    auto const unused = find("rank " + std::to_string(last_rank));
+    ASSERT_EQ(1, unused.num_ranks);
+    ASSERT_EQ(0u, unused.count);
+    ASSERT_EQ(1.0, unused.imbalance);
+
+    std::stringstream csv;
+    eap::comm::PrintTimerStatistics(csv, statistics, eap::comm::TimerStatisticsFormat::Csv);
+    ASSERT_EQ(0u, csv.str().find("name,ranks,count,min,max,mean,stddev,imbalance,slowest_rank\n"
+                                 "\"all ranks\","));
+}
+
+TEST(Timer, WriteTrace) {
+    auto comm = mpi::Comm::world().dup();
+
+    eap::comm::EnableTracing(64);
+    {
+        EAP_COMM_TIME_FUNCTION("eap::comm::WriteTrace test");
+    }
+
+    auto const read = [](std::string const &path) {
+        std::ifstream file(path);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    };
+
+    std::string const prefix = "eap-comm-trace-test";
+
+    eap::comm::WriteTrace(comm.deref(), prefix, eap::comm::TraceOutput::PerRank);
+    auto const rank_path = prefix + "." + std::to_string(comm.rank()) + ".json";
+    auto const rank_trace = read(rank_path);
+    ASSERT_NE(std::string::npos, rank_trace.find("\"name\":\"eap::comm::WriteTrace test\""));
+    ASSERT_NE(std::string::npos,
+              rank_trace.find("\"pid\":" + std::to_string(comm.rank()) + ","));
+    std::remove(rank_path.c_str());
+
+    eap::comm::WriteTrace(comm.deref(), prefix, eap::comm::TraceOutput::Merged);
+    comm.barrier();
+    if (comm.rank() == 0) {
+        auto const merged_trace = read(prefix + ".json");
+        for (int rank = 0; rank < comm.size(); rank++) {
+            ASSERT_NE(std::string::npos,
+                      merged_trace.find("\"pid\":" + std::to_string(rank) + ","));
+        }
+        std::remove((prefix + ".json").c_str());
+    }
+
+    // Every rank throws, rather than waiting on the root, if the root can't open the file
+    ASSERT_THROW(eap::comm::WriteTrace(
+                     comm.deref(), prefix + "-missing/trace", eap::comm::TraceOutput::Merged),
+                 std::runtime_error);
+
+    eap::comm::EnableTracing(0);
+}
+
+namespace {
+void RecordVolumeForTest(std::size_t bytes) {
+    EAP_COMM_TIME_FUNCTION("eap::comm::CommVolume test");
+
+    eap::comm::CommVolume volume;
+    volume.calls = 1;
+    volume.neighbors = 2;
+    volume.receive_batches = 1;
+    volume.RecordSend(bytes);
+    volume.RecordReceive(2 * bytes);
+
+    EAP_COMM_RECORD_VOLUME(volume);
+}
+} // namespace
+
+TEST(Timer, CommVolume) {
+    RecordVolumeForTest(8);
+    std::thread([] { RecordVolumeForTest(16); }).join();
+
+    // Each thread counts separately, and merging sums them
+    auto const volumes = eap::comm::MergeCommVolumes();
+    auto const found = volumes.find("eap::comm::CommVolume test");
+    ASSERT_NE(volumes.end(), found);
+
+    auto const &volume = found->second;
+    EXPECT_EQ(2u, volume.calls);
+    EXPECT_EQ(2u, volume.messages_sent);
+    EXPECT_EQ(2u, volume.messages_received);
+    EXPECT_EQ(24u, volume.bytes_sent);
+    EXPECT_EQ(48u, volume.bytes_received);
+    EXPECT_EQ(4u, volume.neighbors);
+    EXPECT_EQ(32u, volume.max_message_bytes);
+    EXPECT_EQ(2u, volume.receive_batches);
+
+    std::stringstream table;
+    eap::comm::PrintCommVolumes(table, volumes);
+    ASSERT_NE(std::string::npos, table.str().find("eap::comm::CommVolume test"));
+}
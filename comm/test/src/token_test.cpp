@@ -197,6 +197,20 @@ void get_put_test(Test *t) {
 
         EXPECT_EQ(get_ans, recv_data);
 
+        // One value is received from every other rank that has the needed column
+        size_t num_remote = 0;
+        for (rank_t rank = 0; rank < comm.size(); rank++) {
+            if (rank != comm.rank() && comm.rank() * 2 < 10 + rank) {
+                num_remote++;
+            }
+        }
+
+        auto const &volume = token.GetVolume();
+        EXPECT_EQ(1u, volume.calls);
+        EXPECT_EQ(num_remote, volume.messages_received);
+        EXPECT_EQ(num_remote * sizeof(FP), volume.bytes_received);
+        EXPECT_EQ(num_remote > 0 ? 1u : 0u, volume.receive_batches);
+
         for (auto &data : recv_data) {
             data *= 2;
         }
@@ -204,6 +218,8 @@ void get_put_test(Test *t) {
         token.Put(TokenOperation::Copy, recv_data, my_data);
 
         EXPECT_EQ(put_ans, my_data);
+        EXPECT_EQ(2u, token.GetVolume().calls);
+        EXPECT_EQ(num_remote, token.GetVolume().messages_sent);
     }
 }
 
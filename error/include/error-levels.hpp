@@ -0,0 +1,101 @@
+/**
+ * @file error-levels.hpp
+ *
+ * @brief Defines the check levels that select which EAP Error checks are compiled and run
+ * @date 2019-10-01
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef EAP_ERROR_LEVELS_HPP_
+#define EAP_ERROR_LEVELS_HPP_
+
+// STL Includes
+#include <atomic>
+
+/// Checks that are always compiled and run, e.g. EE_ASSERT
+#define EAP_ERROR_LEVEL_ALWAYS 0
+/// Per-call checks of hot routines, e.g. EE_ASSERT_DEBUG and EE_DIAG_PRE_DEBUG
+#define EAP_ERROR_LEVEL_DEBUG 1
+/// Checks that cost as much as the routine they check, e.g. EE_ASSERT_PARANOID
+#define EAP_ERROR_LEVEL_PARANOID 2
+
+/**
+ * @brief The check level used when none is set: EAP_ERROR_LEVEL_DEBUG, or EAP_ERROR_LEVEL_ALWAYS
+ * if NDEBUG is defined.
+ */
+#ifdef NDEBUG
+#define EAP_ERROR_DEFAULT_CHECK_LEVEL EAP_ERROR_LEVEL_ALWAYS
+#else
+#define EAP_ERROR_DEFAULT_CHECK_LEVEL EAP_ERROR_LEVEL_DEBUG
+#endif
+
+/**
+ * @brief The highest check level compiled into code that doesn't belong to a module.
+ *
+ * @details
+ * Used by EE_ASSERT_DEBUG and friends. Like `assert`, checks in headers follow the level of the
+ * translation unit that includes them, so headers of a module test the module's own level with
+ * the `_IN` forms instead, e.g. `EE_ASSERT_DEBUG_IN(EAP_COMM_CHECK_LEVEL, ...)`. CMake defines
+ * `EAP_<MODULE>_CHECK_LEVEL` for a module and everything that links to it (see
+ * cmake/ErrorChecks.cmake), so every translation unit compiles the module's inline code alike.
+ *
+ * Every check level must be defined as one of the EAP_ERROR_LEVEL_* macros.
+ */
+#ifndef EAP_ERROR_CHECK_LEVEL
+#define EAP_ERROR_CHECK_LEVEL EAP_ERROR_DEFAULT_CHECK_LEVEL
+#endif
+
+namespace eap {
+namespace error {
+/**
+ * @brief The levels checks can be run at. See EAP_ERROR_LEVEL_ALWAYS.
+ */
+enum class CheckLevel : int {
+    Always = EAP_ERROR_LEVEL_ALWAYS,
+    Debug = EAP_ERROR_LEVEL_DEBUG,
+    Paranoid = EAP_ERROR_LEVEL_PARANOID
+};
+
+/**
+ * @brief Limits the checks that run to those at or below `level`, in every module.
+ *
+ * @details
+ * Checks that weren't compiled in (see EAP_ERROR_CHECK_LEVEL) can't be turned on, and
+ * EAP_ERROR_LEVEL_ALWAYS checks can't be turned off. The level starts from the environment
+ * variable EAP_ERROR_CHECK_LEVEL ("always", "debug" or "paranoid"), and is CheckLevel::Paranoid,
+ * i.e. every compiled check runs, if that isn't set.
+ */
+void SetCheckLevel(CheckLevel level) noexcept;
+
+/**
+ * @brief Returns the level set by SetCheckLevel
+ */
+CheckLevel GetCheckLevel() noexcept;
+
+namespace internal {
+/// The runtime level as an int, read by every enabled check above EAP_ERROR_LEVEL_ALWAYS
+extern std::atomic<int> runtime_check_level;
+
+inline bool RuntimeCheckEnabled(int level) noexcept {
+    return level <= runtime_check_level.load(std::memory_order_relaxed);
+}
+} // namespace internal
+} // namespace error
+} // namespace eap
+
+/**
+ * @brief Whether checks at `level` (e.g. EAP_ERROR_LEVEL_DEBUG) run in code compiled at
+ * `check_level`. The compile-time part is a constant, so checks above `check_level` are removed
+ * entirely, but still have to compile.
+ */
+#define EAP_ERROR_CHECK_ENABLED_IN(check_level, level)                                             \
+    ((level) <= (check_level) && ::eap::error::internal::RuntimeCheckEnabled(level))
+
+/**
+ * @brief Whether checks at `level` run in the current translation unit. See
+ * EAP_ERROR_CHECK_ENABLED_IN.
+ */
+#define EAP_ERROR_CHECK_ENABLED(level) EAP_ERROR_CHECK_ENABLED_IN(EAP_ERROR_CHECK_LEVEL, level)
+
+#endif // EAP_ERROR_LEVELS_HPP_
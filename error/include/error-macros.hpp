@@ -20,6 +20,7 @@
 
 // Package includes
 #include "error-internal.hpp"
+#include "error-levels.hpp"
 #include "error-records.hpp"
 
 // There's an outstanding bug in VSCode causing constexpr to intersect poorly with cosntant string
@@ -193,6 +194,14 @@
         }                                                                                          \
     } while (false)
 
+/// See: EE_ASSERT_DEBUG_IN
+#define EAP_ERROR_ASSERT_AT(check_level, level, ...)                                               \
+    do {                                                                                           \
+        if (EAP_ERROR_CHECK_ENABLED_IN(check_level, level)) {                                      \
+            EE_ASSERT(__VA_ARGS__);                                                                \
+        }                                                                                          \
+    } while (false)
+
 /// See: EE_RAISE
 #define EAP_ERROR_RAISE_MSG(msg)                                                                   \
     do {                                                                                           \
@@ -281,6 +290,40 @@
         std::exit(EXIT_FAILURE); /* HACK: Intel does not recognize the [[noreturn]] attribute */   \
     }
 
+// A try block can't be switched off at runtime, so the debug tier of EE_DIAG is compile-time only.
+// The check level is pasted onto the macro name, which selects the variant with or without the try
+// block without an #if, so that it can follow a module's level. Stripped, it keeps the prelude and
+// the scope, so that code between PRE and POST is unchanged.
+#define EAP_ERROR_IMPL_CONCAT(a, b) EAP_ERROR_IMPL_CONCAT_EXPANDED(a, b)
+#define EAP_ERROR_IMPL_CONCAT_EXPANDED(a, b) a##b
+
+/// See: EE_DIAG_PRE_DEBUG_IN
+#define EAP_ERROR_DIAG_PRE_DEBUG_IN(check_level)                                                   \
+    EAP_ERROR_IMPL_CONCAT(EAP_ERROR_DIAG_PRE_DEBUG_AT_, check_level)
+/// See: EE_DIAG_PRE_DEBUG_IN
+#define EAP_ERROR_DIAG_POST_DEBUG_IN(check_level)                                                  \
+    EAP_ERROR_IMPL_CONCAT(EAP_ERROR_DIAG_POST_DEBUG_AT_, check_level)
+/// See: EE_DIAG_PRE_DEBUG_IN
+#define EAP_ERROR_DIAG_POST_MSG_DEBUG_IN(check_level, msg)                                         \
+    EAP_ERROR_IMPL_CONCAT(EAP_ERROR_DIAG_POST_MSG_DEBUG_AT_, check_level)(msg)
+
+// EAP_ERROR_LEVEL_ALWAYS
+#define EAP_ERROR_DIAG_PRE_DEBUG_AT_0                                                              \
+    EAP_ERROR_PRELUDE                                                                              \
+    {
+#define EAP_ERROR_DIAG_POST_DEBUG_AT_0 }
+#define EAP_ERROR_DIAG_POST_MSG_DEBUG_AT_0(msg) }
+
+// EAP_ERROR_LEVEL_DEBUG
+#define EAP_ERROR_DIAG_PRE_DEBUG_AT_1 EAP_ERROR_DIAG_PRE
+#define EAP_ERROR_DIAG_POST_DEBUG_AT_1 EAP_ERROR_DIAG_POST
+#define EAP_ERROR_DIAG_POST_MSG_DEBUG_AT_1(msg) EAP_ERROR_DIAG_POST_MSG(msg)
+
+// EAP_ERROR_LEVEL_PARANOID
+#define EAP_ERROR_DIAG_PRE_DEBUG_AT_2 EAP_ERROR_DIAG_PRE
+#define EAP_ERROR_DIAG_POST_DEBUG_AT_2 EAP_ERROR_DIAG_POST
+#define EAP_ERROR_DIAG_POST_MSG_DEBUG_AT_2(msg) EAP_ERROR_DIAG_POST_MSG(msg)
+
 /**
  * @brief Used to abort at `extern "C"` boundaries rather than propagating an exception into non-C++
  * code. Requires `EAP_EXTERN_POST` at the end of the routine. Implies `EAP_ERROR_PRELUDE`.
@@ -355,6 +398,37 @@
 #define EE_ASSERT(...)                                                                             \
     EAP_IMPL_OVERLOAD_MACRO1_2(__VA_ARGS__, EAP_ERROR_ASSERT_MSG, EAP_ERROR_ASSERT)(__VA_ARGS__)
 
+/**
+ * @brief EE_ASSERT at EAP_ERROR_LEVEL_DEBUG, for cheap checks that run on every call of a hot
+ * routine.
+ *
+ * @details
+ * Removed at compile time if `check_level` is EAP_ERROR_LEVEL_ALWAYS, and skipped at runtime if
+ * eap::error::SetCheckLevel lowered the level. Code in a module passes the module's level, e.g.
+ * EAP_COMM_CHECK_LEVEL.
+ *
+ * @param check_level The EAP_ERROR_LEVEL_* the surrounding code is compiled at
+ * @param expr boolean expression
+ * @param msg (Optional) a stream statement that is appended to the error message.
+ */
+#define EE_ASSERT_DEBUG_IN(check_level, ...)                                                       \
+    EAP_ERROR_ASSERT_AT(check_level, EAP_ERROR_LEVEL_DEBUG, __VA_ARGS__)
+
+/**
+ * @brief EE_ASSERT at EAP_ERROR_LEVEL_PARANOID, for checks as expensive as the routine itself.
+ *
+ * @details
+ * Only compiled in if `check_level` is EAP_ERROR_LEVEL_PARANOID. See EE_ASSERT_DEBUG_IN.
+ */
+#define EE_ASSERT_PARANOID_IN(check_level, ...)                                                    \
+    EAP_ERROR_ASSERT_AT(check_level, EAP_ERROR_LEVEL_PARANOID, __VA_ARGS__)
+
+/// EE_ASSERT_DEBUG_IN at the level of the current translation unit, EAP_ERROR_CHECK_LEVEL
+#define EE_ASSERT_DEBUG(...) EE_ASSERT_DEBUG_IN(EAP_ERROR_CHECK_LEVEL, __VA_ARGS__)
+
+/// EE_ASSERT_PARANOID_IN at the level of the current translation unit, EAP_ERROR_CHECK_LEVEL
+#define EE_ASSERT_PARANOID(...) EE_ASSERT_PARANOID_IN(EAP_ERROR_CHECK_LEVEL, __VA_ARGS__)
+
 /**
  * @brief Originates an error
  *
@@ -424,4 +498,34 @@
 /// See: EE_DIAG_PRE
 #define EE_DIAG_POST_MSG EAP_ERROR_DIAG_POST_MSG
 
+/**
+ * @brief EE_DIAG_PRE at EAP_ERROR_LEVEL_DEBUG, for hot routines whose callers already add context.
+ * Must be used with `EE_DIAG_POST_DEBUG_IN` or `EE_DIAG_POST_MSG_DEBUG_IN` at the same
+ * `check_level`. Implies `EE_PRELUDE`.
+ *
+ * @details
+ * The try block keeps the routine from being inlined. If `check_level` is EAP_ERROR_LEVEL_ALWAYS
+ * it is removed, so errors propagate to the caller without this routine's context. Not affected
+ * by eap::error::SetCheckLevel.
+ *
+ * @param check_level The EAP_ERROR_LEVEL_* the surrounding code is compiled at, e.g.
+ * EAP_MESH_CHECK_LEVEL
+ */
+#define EE_DIAG_PRE_DEBUG_IN EAP_ERROR_DIAG_PRE_DEBUG_IN
+
+/// See: EE_DIAG_PRE_DEBUG_IN
+#define EE_DIAG_POST_DEBUG_IN EAP_ERROR_DIAG_POST_DEBUG_IN
+
+/// See: EE_DIAG_PRE_DEBUG_IN
+#define EE_DIAG_POST_MSG_DEBUG_IN EAP_ERROR_DIAG_POST_MSG_DEBUG_IN
+
+/// EE_DIAG_PRE_DEBUG_IN at the level of the current translation unit, EAP_ERROR_CHECK_LEVEL
+#define EE_DIAG_PRE_DEBUG EE_DIAG_PRE_DEBUG_IN(EAP_ERROR_CHECK_LEVEL)
+
+/// See: EE_DIAG_PRE_DEBUG
+#define EE_DIAG_POST_DEBUG EE_DIAG_POST_DEBUG_IN(EAP_ERROR_CHECK_LEVEL)
+
+/// See: EE_DIAG_PRE_DEBUG
+#define EE_DIAG_POST_MSG_DEBUG(msg) EE_DIAG_POST_MSG_DEBUG_IN(EAP_ERROR_CHECK_LEVEL, msg)
+
 #endif // EAP_ERROR_MACROS_HPP_
\ No newline at end of file
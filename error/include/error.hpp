@@ -13,6 +13,7 @@
 #define EAP_ERROR_HPP_
 
 #include "error-internal.hpp"
+#include "error-levels.hpp"
 #include "error-macros.hpp"
 #include "error-records.hpp"
 
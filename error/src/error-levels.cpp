@@ -0,0 +1,52 @@
+/**
+ * @file error-levels.cpp
+ *
+ * @brief Manages the check level selected at runtime.
+ * @date 2019-10-01
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+// Self include
+#include <error-levels.hpp>
+
+// STL Includes
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+// Constant-initialized, so checks run during static initialization see a valid level
+std::atomic<int> eap::error::internal::runtime_check_level{EAP_ERROR_LEVEL_PARANOID};
+
+namespace {
+/**
+ * @brief Applies the EAP_ERROR_CHECK_LEVEL environment variable, if set, before main
+ */
+struct CheckLevelFromEnvironment {
+    CheckLevelFromEnvironment() {
+        auto const level = std::getenv("EAP_ERROR_CHECK_LEVEL");
+        if (!level) {
+            return;
+        }
+
+        if (std::strcmp(level, "always") == 0) {
+            eap::error::SetCheckLevel(eap::error::CheckLevel::Always);
+        } else if (std::strcmp(level, "debug") == 0) {
+            eap::error::SetCheckLevel(eap::error::CheckLevel::Debug);
+        } else if (std::strcmp(level, "paranoid") == 0) {
+            eap::error::SetCheckLevel(eap::error::CheckLevel::Paranoid);
+        } else {
+            std::cerr << "eap::error: Ignoring EAP_ERROR_CHECK_LEVEL='" << level
+                      << "', expected 'always', 'debug' or 'paranoid'" << std::endl;
+        }
+    }
+} const check_level_from_environment;
+} // namespace
+
+void eap::error::SetCheckLevel(CheckLevel const level) noexcept {
+    internal::runtime_check_level.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+eap::error::CheckLevel eap::error::GetCheckLevel() noexcept {
+    return static_cast<CheckLevel>(internal::runtime_check_level.load(std::memory_order_relaxed));
+}
@@ -71,4 +71,124 @@ TEST(Error, ShouldAbort) {
                      EAP_EXTERN_POST
                  }()),
                  "");
-}
\ No newline at end of file
+}
+namespace {
+int HotRoutine(int value) {
+    EE_DIAG_PRE_DEBUG
+
+    EE_ASSERT(value >= 0, "value must not be negative");
+    return value;
+
+    EE_DIAG_POST_MSG_DEBUG(EE_DBG(value))
+}
+
+int HotRoutineAlways(int value) {
+    EE_DIAG_PRE_DEBUG_IN(EAP_ERROR_LEVEL_ALWAYS)
+
+    EE_ASSERT(value >= 0, "value must not be negative");
+    return value;
+
+    EE_DIAG_POST_MSG_DEBUG_IN(EAP_ERROR_LEVEL_ALWAYS, EE_DBG(value))
+}
+
+int HotRoutineParanoid(int value) {
+    EE_DIAG_PRE_DEBUG_IN(EAP_ERROR_LEVEL_PARANOID)
+
+    EE_ASSERT(value >= 0, "value must not be negative");
+    return value;
+
+    EE_DIAG_POST_DEBUG_IN(EAP_ERROR_LEVEL_PARANOID)
+}
+} // namespace
+
+TEST(Error, CheckLevels) {
+    EE_PRELUDE
+
+    using eap::error::CheckLevel;
+
+    constexpr bool debug_compiled = EAP_ERROR_CHECK_LEVEL >= EAP_ERROR_LEVEL_DEBUG;
+    constexpr bool paranoid_compiled = EAP_ERROR_CHECK_LEVEL >= EAP_ERROR_LEVEL_PARANOID;
+
+    auto const initial_level = eap::error::GetCheckLevel();
+    eap::error::SetCheckLevel(CheckLevel::Paranoid);
+
+    auto evaluations = 0;
+    auto const fails = [&]() {
+        evaluations++;
+        return false;
+    };
+
+    // Compiled-in checks run up to the runtime level
+    auto debug_raised = false;
+    try {
+        EE_ASSERT_DEBUG(fails(), "debug check");
+    } catch (eap::error::RaisedError const &) {
+        debug_raised = true;
+    }
+    ASSERT_EQ(debug_compiled, debug_raised);
+
+    auto paranoid_raised = false;
+    try {
+        EE_ASSERT_PARANOID(fails());
+    } catch (eap::error::RaisedError const &) {
+        paranoid_raised = true;
+    }
+    ASSERT_EQ(paranoid_compiled, paranoid_raised);
+
+    // Lowering the level skips the check without evaluating it
+    eap::error::SetCheckLevel(CheckLevel::Always);
+    ASSERT_EQ(CheckLevel::Always, eap::error::GetCheckLevel());
+
+    evaluations = 0;
+    EE_ASSERT_DEBUG(fails());
+    EE_ASSERT_PARANOID(fails());
+    ASSERT_EQ(0, evaluations);
+    ASSERT_THROW(([&]() { EE_ASSERT(fails()); }()), eap::error::RaisedError);
+
+    eap::error::SetCheckLevel(initial_level);
+
+    // The debug tier of EE_DIAG only adds context if it's compiled in
+    ASSERT_EQ(3, HotRoutine(3));
+    try {
+        HotRoutine(-1);
+        FAIL() << "HotRoutine(-1) should have raised";
+    } catch (eap::error::PropagatedError const &) {
+        ASSERT_TRUE(debug_compiled);
+    } catch (eap::error::RaisedError const &) {
+        ASSERT_FALSE(debug_compiled);
+    }
+}
+
+TEST(Error, ModuleCheckLevels) {
+    EE_PRELUDE
+
+    using eap::error::CheckLevel;
+
+    auto const initial_level = eap::error::GetCheckLevel();
+    eap::error::SetCheckLevel(CheckLevel::Paranoid);
+
+    auto evaluations = 0;
+    auto const fails = [&]() {
+        evaluations++;
+        return false;
+    };
+
+    // An explicit level overrides the level of the translation unit
+    EE_ASSERT_DEBUG_IN(EAP_ERROR_LEVEL_ALWAYS, fails());
+    EE_ASSERT_PARANOID_IN(EAP_ERROR_LEVEL_DEBUG, fails());
+    ASSERT_EQ(0, evaluations);
+
+    ASSERT_THROW(([&]() { EE_ASSERT_DEBUG_IN(EAP_ERROR_LEVEL_DEBUG, fails()); }()),
+                 eap::error::RaisedError);
+    ASSERT_THROW(([&]() { EE_ASSERT_PARANOID_IN(EAP_ERROR_LEVEL_PARANOID, fails()); }()),
+                 eap::error::RaisedError);
+    ASSERT_EQ(2, evaluations);
+
+    eap::error::SetCheckLevel(initial_level);
+
+    ASSERT_EQ(3, HotRoutineAlways(3));
+    ASSERT_THROW(HotRoutineAlways(-1), eap::error::RaisedError);
+
+    ASSERT_EQ(3, HotRoutineParanoid(3));
+    ASSERT_THROW(HotRoutineParanoid(-1), eap::error::PropagatedError);
+}
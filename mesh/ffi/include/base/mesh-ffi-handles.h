@@ -58,7 +58,7 @@ typedef enum _eap_mesh_block_layout_method_t {
      */
     eap_mesh_block_layout_method_column_major = 1,
     /**
-     * @brief UNIMPLEMENTED
+     * @brief Blocks are laid out along a Hilbert curve.
      */
     eap_mesh_block_layout_method_hilbert = 2,
     /**
@@ -71,6 +71,10 @@ typedef enum _eap_mesh_block_layout_method_t {
      * second-dimension.
      */
     eap_mesh_block_layout_method_column_major_reverse = 4,
+    /**
+     * @brief Blocks are laid out along a Morton (Z-order) curve.
+     */
+    eap_mesh_block_layout_method_morton = 5,
 } eap_mesh_block_layout_method_t;
 
 /**
@@ -67,6 +67,28 @@ void eap_mesh_block_layout_get_address(eap_mesh_block_layout_t *layout,
                                        uint64_t coordinate2,
                                        uint64_t *address);
 
+/**
+ * @brief Translates an array of block addresses to their 3D coordinates.
+ *
+ * @param layout The BlockLayout object
+ * @param addresses Linear block addresses. uint64_t[n]
+ * @param coordinates Output coordinates of each block. uint64_t[n][3]
+ */
+void eap_mesh_block_layout_get_coordinates_v(eap_mesh_block_layout_t *layout,
+                                             abi_ndarray_t const *addresses,
+                                             abi_ndarray_t const *coordinates);
+
+/**
+ * @brief Translates an array of 3D block coordinates to their addresses.
+ *
+ * @param layout The BlockLayout object
+ * @param coordinates Coordinates of each block. uint64_t[n][3]
+ * @param addresses Output linear block addresses. uint64_t[n]
+ */
+void eap_mesh_block_layout_get_addresses_v(eap_mesh_block_layout_t *layout,
+                                           abi_ndarray_t const *coordinates,
+                                           abi_ndarray_t const *addresses);
+
 EXTERN_C_END
 
 #endif // EAP_MESH_FFI_BLOCKS_H_
\ No newline at end of file
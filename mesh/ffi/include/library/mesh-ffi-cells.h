@@ -61,6 +61,25 @@ int32_t eap_mesh_cpp_cells_to_local(eap_mesh_cpp_cells_t *obj, const int64_t *gl
 
 int64_t eap_mesh_cpp_cells_to_global(eap_mesh_cpp_cells_t *obj, const int32_t *local_index);
 
+/**
+ * @brief Plans a move that balances `weights` across ranks along a space-filling curve. See
+ * eap::mesh::BalanceAlongCurve.
+ *
+ * `renumber_new_to_old` must have an entry per local cell, and the segment arrays an entry per
+ * rank. Cell indices and segment starts are written 1-based, ready for
+ * eap_mesh_cpp_levels_recon_move_f.
+ */
+void eap_mesh_cpp_cells_balance_along_curve(eap_mesh_cpp_cells_t const *obj,
+                                            int32_t numdim,
+                                            eap_mesh_block_layout_method_t method,
+                                            abi_ndarray_t const *weights,
+                                            abi_ndarray_t const *renumber_new_to_old,
+                                            abi_ndarray_t const *send_start,
+                                            abi_ndarray_t const *send_length,
+                                            abi_ndarray_t const *recv_start,
+                                            abi_ndarray_t const *recv_length,
+                                            int32_t *new_num_local_cells);
+
 EXTERN_C_END
 
 #endif // EAP_MESH_FFI_CELLS_H_
\ No newline at end of file
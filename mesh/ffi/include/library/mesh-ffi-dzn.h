@@ -70,6 +70,16 @@ void eap_mesh_split_dzn_filter_kode(eap_mesh_dzn_t const *dznffi,
                                     int level_base,
                                     int *level_set);
 
+void eap_mesh_split_dzn_filter_kode_v(eap_mesh_dzn_t const *dznffi,
+                                      int numdim,
+                                      double time,
+                                      int kode,
+                                      int nlow,
+                                      int nhigh,
+                                      abi_ndarray_t const *points,
+                                      abi_ndarray_t const *level_base,
+                                      abi_ndarray_t const *level_set);
+
 void eap_mesh_process_cells_in_dzn_filter_kode(eap_mesh_dzn_t const *dznffi,
                                                int numdim,
                                                eap_mesh_cpp_cells_t const *cells,
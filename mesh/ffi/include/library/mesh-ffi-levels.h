@@ -33,6 +33,7 @@ typedef struct eap_mesh_cpp_levels_opts {
     bool kid_mom_use_s2s;
     bool mom_kid_use_s2s;
     bool mom_kids_use_s2s;
+    bool level_major_renumbering;
 } eap_mesh_cpp_levels_opts;
 
 FC_INTEROP_CREATE_C_DECL(mesh, cpp_levels);
@@ -47,6 +48,14 @@ void eap_mesh_cpp_levels_build_pack(eap_mesh_cpp_levels_t *levels,
 void eap_mesh_cpp_levels_build_top(eap_mesh_cpp_levels_t *levels,
                                    eap_mesh_cpp_cells_t const *cells);
 
+typedef struct eap_mesh_cpp_levels_renumbering_fields {
+    abi_ndarray_t renumber_new_to_old;
+    abi_ndarray_t renumber_old_to_new;
+} eap_mesh_cpp_levels_renumbering_fields;
+
+void eap_mesh_cpp_levels_get_renumbering(eap_mesh_cpp_levels_t const *levels,
+                                         eap_mesh_cpp_levels_renumbering_fields *fields);
+
 void eap_mesh_cpp_levels_reset_mothers_and_daughters(eap_mesh_cpp_levels_t *levels,
                                                      eap_mesh_cpp_cells_t const *cells);
 
@@ -107,7 +116,8 @@ void eap_mesh_cpp_levels_filter_at_level_f(eap_mesh_cpp_levels_t const *levels,
                                            eap_local_t const level,
                                            abi_ndarray_t const out,
                                            void *context,
-                                           bool (*function)(void *context, eap_local_t cell));
+                                           bool (*function)(void *context, eap_local_t cell),
+                                           eap_local_t *count);
 
 void eap_mesh_cpp_levels_collect_at_level_f(eap_mesh_cpp_levels_t const *levels,
                                             eap_mesh_cpp_cells_t const *cells,
@@ -14,9 +14,12 @@
 #include <memory>
 
 // Internal Includes
+#include <abi-fortran_interop_impl.hpp>
 #include <error-macros.hpp>
 #include <mesh-blocks.hpp>
+#include <mesh-blocks_compute.hpp>
 #include <mesh-ffi-interop.hpp>
+#include <utility-kokkos.hpp>
 
 using eap::mesh::BlockCoordinates;
 using eap::mesh::BlockLayout;
@@ -24,6 +27,7 @@ using eap::mesh::BlockLayoutMethod;
 using eap::mesh::ffi::LayoutFromFFI;
 using eap::mesh::ffi::LayoutMethodFromFFI;
 using eap::mesh::ffi::LayoutToFFI;
+using eap::utility::kokkos::ViewFromNdarray;
 
 EXTERN_C void eap_mesh_block_layout_create(eap_mesh_block_layout_method_t method,
                                            uint64_t extent0,
@@ -73,4 +77,30 @@ EXTERN_C void eap_mesh_block_layout_get_address(eap_mesh_block_layout_t *layout,
         LayoutFromFFI(layout)->GetAddress(BlockCoordinates{coordinate0, coordinate1, coordinate2});
 
     EAP_EXTERN_POST
-}
\ No newline at end of file
+}
+
+EXTERN_C void eap_mesh_block_layout_get_coordinates_v(eap_mesh_block_layout_t *layout,
+                                                      abi_ndarray_t const *addresses,
+                                                      abi_ndarray_t const *coordinates) {
+    EAP_EXTERN_PRE
+
+    eap::mesh::GetBlockCoordinates<Kokkos::DefaultHostExecutionSpace>(
+        *LayoutFromFFI(layout),
+        ViewFromNdarray<uint64_t const *>(*addresses),
+        ViewFromNdarray<uint64_t **>(*coordinates));
+
+    EAP_EXTERN_POST
+}
+
+EXTERN_C void eap_mesh_block_layout_get_addresses_v(eap_mesh_block_layout_t *layout,
+                                                    abi_ndarray_t const *coordinates,
+                                                    abi_ndarray_t const *addresses) {
+    EAP_EXTERN_PRE
+
+    eap::mesh::GetBlockAddresses<Kokkos::DefaultHostExecutionSpace>(
+        *LayoutFromFFI(layout),
+        ViewFromNdarray<uint64_t const **>(*coordinates),
+        ViewFromNdarray<uint64_t *>(*addresses));
+
+    EAP_EXTERN_POST
+}
@@ -17,15 +17,20 @@
 #include <abi-fortran_interop_impl.hpp>
 #include <comm-ffi-interop.hpp>
 #include <error-macros.hpp>
+#include <mesh-balance.hpp>
 #include <mesh-cells.hpp>
+#include <utility-kokkos.hpp>
 
 // Local Includes
 #include <mesh-ffi-interop.hpp>
 
+using eap::local_index_t;
 using eap::comm::ffi::TokenBuilderFromFFI;
 using eap::mesh::Cells;
 using eap::mesh::ffi::CellsFromFFI;
 using eap::mesh::ffi::CellsToFFI;
+using eap::mesh::ffi::LayoutMethodFromFFI;
+using eap::utility::kokkos::ViewFromNdarray;
 
 FROM_HANDLE_INTERNAL_IMPL_NON_CONST_ONLY(mesh, cpp_cells, Cells)
 
@@ -116,4 +121,42 @@ int64_t eap_mesh_cpp_cells_to_global(eap_mesh_cpp_cells_t *obj, const int32_t *l
     EAP_EXTERN_POST
 }
 
+void eap_mesh_cpp_cells_balance_along_curve(eap_mesh_cpp_cells_t const *obj,
+                                            int32_t numdim,
+                                            eap_mesh_block_layout_method_t method,
+                                            abi_ndarray_t const *weights,
+                                            abi_ndarray_t const *renumber_new_to_old,
+                                            abi_ndarray_t const *send_start,
+                                            abi_ndarray_t const *send_length,
+                                            abi_ndarray_t const *recv_start,
+                                            abi_ndarray_t const *recv_length,
+                                            int32_t *new_num_local_cells) {
+    EAP_EXTERN_PRE
+
+    auto const balance = eap::mesh::BalanceAlongCurve(*CellsFromFFI(obj),
+                                                      numdim,
+                                                      ViewFromNdarray<double const *>(*weights),
+                                                      LayoutMethodFromFFI(method));
+
+    auto const new_to_old = ViewFromNdarray<int32_t *>(*renumber_new_to_old);
+    for (size_t i = 0; i < balance.renumber_new_to_old.extent(0); i++) {
+        new_to_old(i) = local_index_t(balance.renumber_new_to_old(i)) + 1;
+    }
+
+    auto const out_send_start = ViewFromNdarray<int32_t *>(*send_start);
+    auto const out_send_length = ViewFromNdarray<int32_t *>(*send_length);
+    auto const out_recv_start = ViewFromNdarray<int32_t *>(*recv_start);
+    auto const out_recv_length = ViewFromNdarray<int32_t *>(*recv_length);
+    for (size_t k = 0; k < balance.send_length.size(); k++) {
+        out_send_start(k) = local_index_t(balance.send_start[k]) + 1;
+        out_send_length(k) = balance.send_length[k];
+        out_recv_start(k) = local_index_t(balance.recv_start[k]) + 1;
+        out_recv_length(k) = balance.recv_length[k];
+    }
+
+    *new_num_local_cells = balance.new_num_local_cells;
+
+    EAP_EXTERN_POST
+}
+
 EXTERN_C_END
@@ -130,6 +130,30 @@ EXTERN_C void eap_mesh_split_dzn_filter_kode(eap_mesh_dzn_t const *dznffi,
     EAP_EXTERN_POST
 }
 
+EXTERN_C void eap_mesh_split_dzn_filter_kode_v(eap_mesh_dzn_t const *dznffi,
+                                               int numdim,
+                                               double time,
+                                               int kode,
+                                               int nlow,
+                                               int nhigh,
+                                               abi_ndarray_t const *points,
+                                               abi_ndarray_t const *level_base,
+                                               abi_ndarray_t const *level_set) {
+    EAP_EXTERN_PRE
+
+    auto &dzn = *DefinedZoneResolutionInfoFromFFI(dznffi);
+
+    eap::mesh::SplitDZNsFilterKode(dzn.SubView(nlow, nhigh),
+                                   static_cast<uint8_t>(numdim),
+                                   time,
+                                   static_cast<eap::mesh::Kode>(kode),
+                                   ViewFromNdarray<double const **>(*points),
+                                   ViewFromNdarray<local_index_t const *>(*level_base),
+                                   ViewFromNdarray<local_index_t *>(*level_set));
+
+    EAP_EXTERN_POST
+}
+
 EXTERN_C void eap_mesh_process_cells_in_dzn_filter_kode(eap_mesh_dzn_t const *dznffi,
                                                         int numdim,
                                                         eap_mesh_cpp_cells_t const *cells,
@@ -61,8 +61,10 @@ EXTERN_C void eap_mesh_cpp_levels_initialize(eap_mesh_cpp_levels_t *levels,
     eap::mesh::LevelOptions const level_opts{
         options->num_dim,
         {options->cell_size[0], options->cell_size[1], options->cell_size[2]},
-        eap::mesh::KidMomOptions{
-            options->kid_mom_use_s2s, options->mom_kid_use_s2s, options->mom_kids_use_s2s}};
+        eap::mesh::KidMomOptions{options->kid_mom_use_s2s,
+                                 options->mom_kid_use_s2s,
+                                 options->mom_kids_use_s2s,
+                                 options->level_major_renumbering}};
 
     LevelsFromFFI(levels)->Initialize(level_opts);
 
@@ -95,6 +97,18 @@ EXTERN_C void eap_mesh_cpp_levels_build_top(eap_mesh_cpp_levels_t *levels,
     EAP_EXTERN_POST
 }
 
+EXTERN_C void eap_mesh_cpp_levels_get_renumbering(eap_mesh_cpp_levels_t const *levelsffi,
+                                                  eap_mesh_cpp_levels_renumbering_fields *fields) {
+    EAP_EXTERN_PRE
+
+    auto const &levels = *LevelsFromFFI(levelsffi);
+
+    fields->renumber_new_to_old = ViewToNdarray(levels.RenumberNewToOld());
+    fields->renumber_old_to_new = ViewToNdarray(levels.RenumberOldToNew());
+
+    EAP_EXTERN_POST
+}
+
 EXTERN_C void eap_mesh_cpp_levels_reset_mothers_and_daughters(eap_mesh_cpp_levels_t *levels,
                                                               eap_mesh_cpp_cells_t const *cells) {
     EAP_EXTERN_PRE
@@ -231,15 +245,19 @@ EXTERN_C void eap_mesh_cpp_levels_filter_at_level_f(eap_mesh_cpp_levels_t const
                                                     abi_ndarray_t const out,
                                                     void *context,
                                                     bool (*function)(void *context,
-                                                                     eap_local_t cell)) {
+                                                                     eap_local_t cell),
+                                                    eap_local_t *count) {
     EAP_EXTERN_PRE
 
-    LevelsFromFFI(levels)->FilterAtLevel(level_convert(level),
-                                         CellsFromFFI(cells)->num_local_cells(),
-                                         ViewFromNdarray<FortranLocalIndex *>(out),
-                                         [context, function](auto const l) {
-                                             return function(context, static_cast<eap_local_t>(l));
-                                         });
+    auto const filter_count = LevelsFromFFI(levels)->FilterAtLevel<Serial, HostMemorySpace>(
+        level_convert(level),
+        CellsFromFFI(cells)->num_local_cells(),
+        ViewFromNdarray<FortranLocalIndex *>(out),
+        KOKKOS_LAMBDA(local_index_t const l) {
+            return function(context, static_cast<eap_local_t>(l));
+        });
+
+    *count = static_cast<eap_local_t>(filter_count);
 
     EAP_EXTERN_POST
 }
@@ -0,0 +1,98 @@
+/**
+ * @file mesh-balance.hpp
+ *
+ * @brief Balances per-cell work across ranks by cutting a space-filling curve through the cells
+ * @date 2019-09-20
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef EAP_MESH_BALANCE_HPP_
+#define EAP_MESH_BALANCE_HPP_
+
+// STL Includes
+#include <cstddef>
+#include <vector>
+
+// Third Party Includes
+#include <Kokkos_Core.hpp>
+
+// Local Includes
+#include "mesh-blocks.hpp"
+#include "mesh-cells.hpp"
+#include "mesh-renumber.hpp"
+#include "mesh-types.hpp"
+
+namespace eap {
+namespace mesh {
+/**
+ * @brief A plan for moving cells so that every rank holds an equal share of the total weight.
+ *
+ * @details
+ *  Cells are ordered along a space-filling curve through their `cell_center`, and the curve is
+ *  cut where the global running sum of weights, taken in curve order over all ranks, crosses each
+ *  rank's share. Each rank receives every cell whose key lies in its own range of the curve, so
+ *  after the move the ranks hold consecutive pieces of the curve regardless of where the cells
+ *  started. The local cells are first renumbered into curve order with `ApplyRenumbering`, after
+ *  which the cells sent to each rank are a contiguous segment and the segment arrays can be
+ *  handed directly to `Levels::ReconMove` or `comm::Move`.
+ *
+ *  Received cells are grouped by the rank they came from, so they are not sorted along the curve.
+ */
+struct CurveBalance {
+    /// For each position along the curve, the current index of the local cell placed there
+    MeshView<FortranLocalIndex *> renumber_new_to_old;
+
+    /// Start of the renumbered cells sent to each rank
+    std::vector<FortranLocalIndex> send_start;
+    /// Number of renumbered cells sent to each rank
+    std::vector<local_index_t> send_length;
+    /// Start of the cells received from each rank
+    std::vector<FortranLocalIndex> recv_start;
+    /// Number of cells received from each rank
+    std::vector<local_index_t> recv_length;
+
+    /// Number of local cells after the move
+    local_index_t new_num_local_cells = 0;
+
+    /**
+     * @brief Permutes the local cells of `data` in-place into curve order
+     *
+     * @tparam View 1D or 2D host array type, indexed by cell in the first dimension
+     * @param data Array to renumber. Must have at least num_local_cells entries.
+     */
+    template <typename View>
+    void ApplyRenumbering(View const &data) const {
+        eap::mesh::ApplyRenumbering(renumber_new_to_old, data);
+    }
+};
+
+/**
+ * @brief Plans a move that balances `weights` across the ranks of the world communicator.
+ *
+ * @details
+ *  Collective. Costs all-reductions for the bounding box of the cell centers and the total
+ *  weight, one all-reduction of num_ranks - 1 values per bit of the curve keys (at most 64) to
+ *  bisect for the cut points, and one all-to-all of the send lengths. Everything else is local.
+ *  Invalid weights on any rank make every rank throw.
+ *
+ *  Arrays passed to `Levels::ReconMove` afterwards need room for
+ *  max(num_local_cells, new_num_local_cells) entries.
+ *
+ * @param cells Cells to balance. Uses `num_local_cells()` and `cell_center()`.
+ * @param numdim Number of dimensions of `cell_center()`, in [1, 3]
+ * @param weights Non-negative cost of each local cell. If every weight is zero, cells are
+ * balanced by count instead.
+ * @param method Curve to order the cells along. Must be BlockLayoutMethod::Hilbert or
+ * BlockLayoutMethod::Morton.
+ */
+CurveBalance BalanceAlongCurve(Cells const &cells,
+                               int numdim,
+                               Kokkos::View<double const *,
+                                            Kokkos::LayoutStride,
+                                            eap::HostMemorySpace> weights,
+                               BlockLayoutMethod method = BlockLayoutMethod::Hilbert);
+} // namespace mesh
+} // namespace eap
+
+#endif // EAP_MESH_BALANCE_HPP_
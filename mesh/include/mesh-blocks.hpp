@@ -48,7 +48,11 @@ enum class BlockLayoutMethod {
      */
     ColumnMajor = 1,
     /**
-     * @brief UNIMPLEMENTED
+     * @brief Blocks are laid out along a Hilbert curve.
+     *
+     * Only the dimensions with an extent > 1 are curved. Extents that aren't a power of two are
+     * handled by visiting the blocks in the order of the Hilbert curve over the enclosing
+     * power-of-two cube, skipping the blocks that fall outside the extents.
      */
     Hilbert = 2,
     /**
@@ -61,6 +65,11 @@ enum class BlockLayoutMethod {
      * second-dimension.
      */
     ColumnMajorReverse = 4,
+    /**
+     * @brief Blocks are laid out along a Morton (Z-order) curve, handling non-power-of-two
+     * extents in the same way as Hilbert.
+     */
+    Morton = 5,
 };
 
 /**
@@ -102,6 +111,282 @@ class UnknownBlockLayoutMethodError : public std::invalid_argument {
  */
 using BlockCoordinates = Coordinates<global_index_t>;
 
+namespace internal {
+/// Coordinates of a block in the curved dimensions only
+using CurvePoint = Kokkos::Array<global_index_t, 3>;
+
+/**
+ * @brief Interleaves the low `bits` bits of the first `n` coordinates of `x`, most significant
+ * bits first.
+ */
+KOKKOS_INLINE_FUNCTION global_index_t Interleave(CurvePoint const &x, unsigned bits, unsigned n) {
+    global_index_t index = 0;
+    for (auto b = bits; b-- > 0;) {
+        for (unsigned i = 0; i < n; i++) {
+            index = (index << 1) | ((x[i] >> b) & 1);
+        }
+    }
+    return index;
+}
+
+/**
+ * @brief Inverse of Interleave
+ */
+KOKKOS_INLINE_FUNCTION CurvePoint Deinterleave(global_index_t index, unsigned bits, unsigned n) {
+    CurvePoint x{0, 0, 0};
+    for (unsigned b = 0; b < bits; b++) {
+        for (auto i = n; i-- > 0;) {
+            x[i] |= (index & 1) << b;
+            index >>= 1;
+        }
+    }
+    return x;
+}
+
+/**
+ * @brief Returns the index of `x` along the Hilbert curve over a 2^bits cube in `n` dimensions
+ *
+ * Uses the transpose form from J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707
+ * (2004).
+ */
+KOKKOS_INLINE_FUNCTION global_index_t HilbertIndex(CurvePoint x, unsigned bits, unsigned n) {
+    // A Hilbert curve in one dimension is just a line
+    if (n < 2 || bits == 0) return x[0];
+
+    global_index_t const m = global_index_t(1) << (bits - 1);
+
+    // Undo the rotations and reflections of each sub-cube, top bit first
+    for (auto q = m; q > 1; q >>= 1) {
+        auto const p = q - 1;
+        for (unsigned i = 0; i < n; i++) {
+            if (x[i] & q) {
+                x[0] ^= p;
+            } else {
+                auto const t = (x[0] ^ x[i]) & p;
+                x[0] ^= t;
+                x[i] ^= t;
+            }
+        }
+    }
+
+    // Gray encode
+    for (unsigned i = 1; i < n; i++) {
+        x[i] ^= x[i - 1];
+    }
+
+    global_index_t t = 0;
+    for (auto q = m; q > 1; q >>= 1) {
+        if (x[n - 1] & q) t ^= q - 1;
+    }
+
+    for (unsigned i = 0; i < n; i++) {
+        x[i] ^= t;
+    }
+
+    return Interleave(x, bits, n);
+}
+
+/**
+ * @brief Inverse of HilbertIndex
+ */
+KOKKOS_INLINE_FUNCTION CurvePoint HilbertPoint(global_index_t index, unsigned bits, unsigned n) {
+    if (n < 2 || bits == 0) return CurvePoint{index, 0, 0};
+
+    auto x = Deinterleave(index, bits, n);
+
+    // Gray decode
+    auto t = x[n - 1] >> 1;
+    for (auto i = n - 1; i > 0; i--) {
+        x[i] ^= x[i - 1];
+    }
+    x[0] ^= t;
+
+    // Redo the rotations and reflections of each sub-cube, bottom bit first
+    for (global_index_t q = 2; q != (global_index_t(1) << bits); q <<= 1) {
+        auto const p = q - 1;
+        for (auto i = n; i-- > 0;) {
+            if (x[i] & q) {
+                x[0] ^= p;
+            } else {
+                t = (x[0] ^ x[i]) & p;
+                x[0] ^= t;
+                x[i] ^= t;
+            }
+        }
+    }
+
+    return x;
+}
+
+/**
+ * @brief Returns the index of `point` along the curve of `method` over a 2^bits cube in the first
+ * `num_dims` dimensions.
+ *
+ * @param method Must be BlockLayoutMethod::Hilbert or BlockLayoutMethod::Morton
+ * @param point Coordinates in [0, 2^bits). Only the first `num_dims` are used.
+ * @param bits Bits per coordinate. `bits * num_dims` must be <= 64.
+ * @param num_dims Number of dimensions, in [1, 3]
+ */
+KOKKOS_INLINE_FUNCTION global_index_t CurveIndex(BlockLayoutMethod method,
+                                                 CurvePoint const &point,
+                                                 unsigned bits,
+                                                 unsigned num_dims) {
+    return method == BlockLayoutMethod::Hilbert ? HilbertIndex(point, bits, num_dims)
+                                                : Interleave(point, bits, num_dims);
+}
+
+/**
+ * @brief Inverse of CurveIndex
+ */
+KOKKOS_INLINE_FUNCTION CurvePoint CurvePointAt(BlockLayoutMethod method,
+                                               global_index_t index,
+                                               unsigned bits,
+                                               unsigned num_dims) {
+    return method == BlockLayoutMethod::Hilbert ? HilbertPoint(index, bits, num_dims)
+                                                : Deinterleave(index, bits, num_dims);
+}
+
+/**
+ * @brief Converts between addresses and coordinates of a Hilbert or Morton BlockLayout.
+ *
+ * @details
+ *  The curve visits each aligned sub-cube of the enclosing power-of-two cube in one contiguous
+ *  run of indices, so the address of a block is found by walking down the sub-cubes that contain
+ *  it and counting the blocks inside the extents in the sub-cubes visited before them. Nothing is
+ *  stored per block, so constructing one is cheap at any size and it can be copied into kernels.
+ *  Arguments aren't bounds checked.
+ */
+class BlockCurve {
+  public:
+    BlockCurve() = default;
+
+    /**
+     * @brief Construct a new BlockCurve object
+     *
+     * @param method Must be BlockLayoutMethod::Hilbert or BlockLayoutMethod::Morton
+     * @param extents Extents of the block grid. Each must be >= 1.
+     * @throws std::range_error if the curve index of a block wouldn't fit in 64 bits
+     */
+    BlockCurve(BlockLayoutMethod method, std::array<global_index_t, 3> const &extents);
+
+    /** @brief Coordinates of the block at `address` along the curve */
+    KOKKOS_INLINE_FUNCTION BlockCoordinates GetCoordinates(global_index_t address) const {
+        // A one-dimensional curve is the identity
+        if (num_dims_ < 2) return ToBlock(CurvePoint{address, 0, 0});
+
+        // Descend into the child sub-cube holding the block at `address`
+        global_index_t prefix = 0;
+        for (unsigned level = 0; level < bits_; level++) {
+            if (IsFull(prefix, level)) return ToBlock(PointAt(FirstIndex(prefix, level) + address));
+
+            for (global_index_t child = 0; child < (global_index_t(1) << num_dims_); child++) {
+                auto const count = Count((prefix << num_dims_) | child, level + 1);
+                if (address < count) {
+                    prefix = (prefix << num_dims_) | child;
+                    break;
+                }
+                address -= count;
+            }
+        }
+
+        return ToBlock(PointAt(prefix));
+    }
+
+    /** @brief Address along the curve of the block at `coords` */
+    KOKKOS_INLINE_FUNCTION global_index_t GetAddress(BlockCoordinates const &coords) const {
+        global_index_t const linear[3] = {coords.x, coords.y, coords.z};
+
+        CurvePoint point{0, 0, 0};
+        for (unsigned i = 0; i < num_dims_; i++) {
+            point[i] = linear[dims_[i]];
+        }
+
+        if (num_dims_ < 2) return point[0];
+
+        auto const index = CurveIndex(method_, point, bits_, num_dims_);
+
+        // Count the blocks in the sub-cubes visited before the ones holding `coords`
+        global_index_t address = 0;
+        for (unsigned level = 0; level < bits_; level++) {
+            auto const prefix = Prefix(index, level);
+            if (IsFull(prefix, level)) return address + (index - FirstIndex(prefix, level));
+
+            for (auto child = prefix << num_dims_; child < Prefix(index, level + 1); child++) {
+                address += Count(child, level + 1);
+            }
+        }
+
+        return address;
+    }
+
+  private:
+    BlockLayoutMethod method_ = BlockLayoutMethod::Hilbert;
+    global_index_t extents_[3] = {1, 1, 1};
+    /// The dimensions with an extent > 1, which are the only ones curved
+    unsigned dims_[3] = {0, 0, 0};
+    unsigned num_dims_ = 0;
+    /// Bits per coordinate of the enclosing power-of-two cube
+    unsigned bits_ = 0;
+
+    /** @brief Prefix of `index` naming its sub-cube at `level` */
+    KOKKOS_INLINE_FUNCTION global_index_t Prefix(global_index_t index, unsigned level) const {
+        return level == 0 ? 0 : index >> ((bits_ - level) * num_dims_);
+    }
+
+    /** @brief First curve index in the sub-cube `prefix` at `level` */
+    KOKKOS_INLINE_FUNCTION global_index_t FirstIndex(global_index_t prefix, unsigned level) const {
+        return level == 0 ? 0 : prefix << ((bits_ - level) * num_dims_);
+    }
+
+    KOKKOS_INLINE_FUNCTION CurvePoint PointAt(global_index_t index) const {
+        return CurvePointAt(method_, index, bits_, num_dims_);
+    }
+
+    /** @brief Lowest corner of the sub-cube `prefix` at `level` */
+    KOKKOS_INLINE_FUNCTION CurvePoint Corner(global_index_t prefix, unsigned level) const {
+        auto corner = PointAt(FirstIndex(prefix, level));
+        for (unsigned i = 0; i < num_dims_; i++) {
+            corner[i] &= ~((global_index_t(1) << (bits_ - level)) - 1);
+        }
+        return corner;
+    }
+
+    /** @brief Number of blocks inside the extents in the sub-cube `prefix` at `level` */
+    KOKKOS_INLINE_FUNCTION global_index_t Count(global_index_t prefix, unsigned level) const {
+        auto const side = global_index_t(1) << (bits_ - level);
+        auto const corner = Corner(prefix, level);
+
+        global_index_t count = 1;
+        for (unsigned i = 0; i < num_dims_; i++) {
+            auto const extent = extents_[dims_[i]];
+            if (corner[i] >= extent) return 0;
+            count *= extent - corner[i] < side ? extent - corner[i] : side;
+        }
+        return count;
+    }
+
+    /** @brief Tests whether the sub-cube `prefix` at `level` is entirely inside the extents */
+    KOKKOS_INLINE_FUNCTION bool IsFull(global_index_t prefix, unsigned level) const {
+        auto const side = global_index_t(1) << (bits_ - level);
+        auto const corner = Corner(prefix, level);
+
+        for (unsigned i = 0; i < num_dims_; i++) {
+            if (corner[i] + side > extents_[dims_[i]]) return false;
+        }
+        return true;
+    }
+
+    /** @brief Coordinates of the block at `point` in the curved dimensions */
+    KOKKOS_INLINE_FUNCTION BlockCoordinates ToBlock(CurvePoint const &point) const {
+        global_index_t linear[3] = {0, 0, 0};
+        for (unsigned i = 0; i < num_dims_; i++) {
+            linear[dims_[i]] = point[i];
+        }
+        return BlockCoordinates{linear[0], linear[1], linear[2]};
+    }
+};
+} // namespace internal
+
 /**
  * @brief Thrown when invalid extent values are supplied to a function taking a set of extents.
  */
@@ -276,6 +561,21 @@ class BlockLayout {
      */
     std::array<global_index_t, 3> extents() const noexcept { return extents_; }
 
+    /**
+     * @brief Returns the method the blocks are laid out with.
+     *
+     * @return BlockLayoutMethod
+     */
+    BlockLayoutMethod method() const noexcept { return method_; }
+
+    /**
+     * @brief For curve layouts, the conversion between addresses and coordinates along the curve.
+     * Default constructed otherwise.
+     *
+     * @return internal::BlockCurve const&
+     */
+    internal::BlockCurve const &curve() const noexcept { return curve_; }
+
     /**
      * @brief Gets the coordinates of some arbitrary block address.
      *
@@ -299,7 +599,7 @@ class BlockLayout {
         }
         DIAGNOSTIC_POP
 
-        switch (method) {
+        switch (method_) {
         case BlockLayoutMethod::ColumnMajor:
             return BlockCoordinates{
                 address % imax(),
@@ -323,10 +623,11 @@ class BlockLayout {
                 (address / imax()) % kmax(),
             };
         case BlockLayoutMethod::Hilbert:
-            throw std::runtime_error("Hilbert blocks are not implemented.");
+        case BlockLayoutMethod::Morton:
+            return curve_.GetCoordinates(address);
         }
 
-        throw UnknownBlockLayoutMethodError(method);
+        throw UnknownBlockLayoutMethodError(method_);
     }
 
     global_index_t GetAddress(BlockCoordinates const &coords) const {
@@ -342,7 +643,7 @@ class BlockLayout {
         }
         DIAGNOSTIC_POP
 
-        switch (method) {
+        switch (method_) {
         case BlockLayoutMethod::ColumnMajor:
             return coords.z * ijmax() + coords.y * imax() + coords.x;
         case BlockLayoutMethod::ColumnMajorZigZag: {
@@ -353,16 +654,20 @@ class BlockLayout {
         case BlockLayoutMethod::ColumnMajorReverse:
             return coords.y * ikmax() + coords.z * imax() + coords.x;
         case BlockLayoutMethod::Hilbert:
-            throw std::runtime_error("Hilbert blocks are not implemented.");
+        case BlockLayoutMethod::Morton:
+            return curve_.GetAddress(coords);
         }
 
-        throw UnknownBlockLayoutMethodError(method);
+        throw UnknownBlockLayoutMethodError(method_);
     }
 
   private:
-    BlockLayoutMethod method;
+    BlockLayoutMethod method_;
     std::array<global_index_t, 3> extents_;
 
+    /// For curve layouts, the conversion between addresses and coordinates along the curve
+    internal::BlockCurve curve_;
+
     global_index_t imax() const noexcept { return extents_[0]; }
     global_index_t jmax() const noexcept { return extents_[1]; }
     global_index_t kmax() const noexcept { return extents_[2]; }
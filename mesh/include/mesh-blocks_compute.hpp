@@ -0,0 +1,327 @@
+/**
+ * @file mesh-blocks_compute.hpp
+ *
+ * @brief Bulk conversion between block addresses and block coordinates
+ * @date 2019-09-12
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef EAP_MESH_BLOCKS_COMPUTE_HPP_
+#define EAP_MESH_BLOCKS_COMPUTE_HPP_
+
+// STL Includes
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Third Party Includes
+#include <Kokkos_Core.hpp>
+
+// Internal Includes
+#include <utility-fast_divide.hpp>
+#include <utility-memory.hpp>
+
+// Local Includes
+#include <mesh-blocks.hpp>
+
+namespace eap {
+namespace mesh {
+namespace internal {
+/**
+ * @brief View types of the bulk BlockLayout API in `MemorySpace`.
+ *
+ * @details
+ *  Naming the views through a nested type keeps `MemorySpace` from being deduced from the
+ *  arguments, so callers can pass any view that converts to them.
+ */
+template <typename MemorySpace>
+struct BlockViews {
+    using addresses_type = Kokkos::View<global_index_t const *, Kokkos::LayoutStride, MemorySpace>;
+    using out_addresses_type = Kokkos::View<global_index_t *, Kokkos::LayoutStride, MemorySpace>;
+    using coordinates_type =
+        Kokkos::View<global_index_t const **, Kokkos::LayoutStride, MemorySpace>;
+    using out_coordinates_type =
+        Kokkos::View<global_index_t **, Kokkos::LayoutStride, MemorySpace>;
+};
+} // namespace internal
+
+/**
+ * @brief Gets the coordinates of each address in `addresses`.
+ *
+ * @details
+ *  Same as calling BlockLayout::GetCoordinates for each address, but the layout method is
+ *  dispatched once and the addresses are converted in one parallel kernel.
+ *
+ * @tparam ExecutionSpace
+ *  Where to convert the addresses
+ * @tparam MemorySpace
+ *  Where `addresses` and `coordinates` live. Must be accessible from `ExecutionSpace`
+ * @param layout
+ *  The block layout
+ * @param addresses
+ *  Addresses to convert. Each must be in the range [0, layout.size())
+ * @param coordinates
+ *  Output coordinates. `coordinates(i, d)` is the coordinate of `addresses(i)` in dimension d
+ */
+template <typename ExecutionSpace = Kokkos::DefaultExecutionSpace,
+          typename MemorySpace = eap::HostMemorySpace>
+void GetBlockCoordinates(
+    BlockLayout const &layout,
+    typename internal::BlockViews<MemorySpace>::addresses_type addresses,
+    typename internal::BlockViews<MemorySpace>::out_coordinates_type coordinates);
+
+/**
+ * @brief Gets the address of each set of coordinates in `coordinates`.
+ *
+ * @details
+ *  Same as calling BlockLayout::GetAddress for each set of coordinates, but the layout method is
+ *  dispatched once and the coordinates are converted in one parallel kernel.
+ *
+ * @tparam ExecutionSpace
+ *  Where to convert the coordinates
+ * @tparam MemorySpace
+ *  Where `coordinates` and `addresses` live. Must be accessible from `ExecutionSpace`
+ * @param layout
+ *  The block layout
+ * @param coordinates
+ *  Coordinates to convert. `coordinates(i, d)` is coordinate d of block i
+ * @param addresses
+ *  Output addresses
+ */
+template <typename ExecutionSpace = Kokkos::DefaultExecutionSpace,
+          typename MemorySpace = eap::HostMemorySpace>
+void GetBlockAddresses(BlockLayout const &layout,
+                       typename internal::BlockViews<MemorySpace>::coordinates_type coordinates,
+                       typename internal::BlockViews<MemorySpace>::out_addresses_type addresses);
+
+namespace internal {
+/**
+ * @brief A copy of a BlockLayout that can be used in kernels in `MemorySpace`.
+ *
+ * @details
+ *  Divisions by the extents use precomputed FastDivisors, and the layout method is a template
+ *  parameter of each conversion so the dispatch happens outside of the kernel. Curve layouts are
+ *  converted by a copy of their BlockCurve, so constructing a map allocates nothing. The
+ *  arguments aren't bounds checked.
+ */
+template <typename MemorySpace>
+class BlockLayoutMap {
+  public:
+    explicit BlockLayoutMap(BlockLayout const &layout)
+        : imax_(layout.extents()[0]),
+          jmax_(layout.extents()[1]),
+          kmax_(layout.extents()[2]),
+          div_imax_(imax_),
+          div_jmax_(jmax_),
+          div_kmax_(kmax_),
+          curve_(layout.curve()) {}
+
+    /** @brief Number of blocks in the layout */
+    KOKKOS_INLINE_FUNCTION global_index_t size() const { return imax_ * jmax_ * kmax_; }
+
+    /** @brief Same as BlockLayout::GetCoordinates for layouts using `Method` */
+    template <BlockLayoutMethod Method>
+    KOKKOS_INLINE_FUNCTION BlockCoordinates GetCoordinates(global_index_t address) const {
+        if (Method == BlockLayoutMethod::Hilbert || Method == BlockLayoutMethod::Morton) {
+            return curve_.GetCoordinates(address);
+        }
+
+        auto const row = div_imax_.Divide(address);
+        auto const i = address - row * imax_;
+
+        BlockCoordinates coords;
+        if (Method == BlockLayoutMethod::ColumnMajorReverse) {
+            coords.x = i;
+            coords.y = div_kmax_.Divide(row);
+            coords.z = row - coords.y * kmax_;
+        } else {
+            coords.x = i;
+            coords.z = div_jmax_.Divide(row);
+            coords.y = row - coords.z * jmax_;
+
+            if (Method == BlockLayoutMethod::ColumnMajorZigZag && (coords.y % 2) == 1) {
+                coords.x = imax_ - i - 1;
+            }
+        }
+
+        return coords;
+    }
+
+    /** @brief Same as BlockLayout::GetAddress for layouts using `Method` */
+    template <BlockLayoutMethod Method>
+    KOKKOS_INLINE_FUNCTION global_index_t GetAddress(global_index_t x,
+                                                     global_index_t y,
+                                                     global_index_t z) const {
+        switch (Method) {
+        case BlockLayoutMethod::ColumnMajor:
+            return (z * jmax_ + y) * imax_ + x;
+        case BlockLayoutMethod::ColumnMajorZigZag:
+            return (z * jmax_ + y) * imax_ + ((y % 2) == 1 ? (imax_ - x - 1) : x);
+        case BlockLayoutMethod::ColumnMajorReverse:
+            return (y * kmax_ + z) * imax_ + x;
+        case BlockLayoutMethod::Hilbert:
+        case BlockLayoutMethod::Morton:
+            return curve_.GetAddress(BlockCoordinates{x, y, z});
+        }
+
+        return 0;
+    }
+
+  private:
+    global_index_t imax_;
+    global_index_t jmax_;
+    global_index_t kmax_;
+
+    utility::FastDivisor div_imax_;
+    utility::FastDivisor div_jmax_;
+    utility::FastDivisor div_kmax_;
+
+    BlockCurve curve_;
+};
+
+/**
+ * @brief Calls `fn(std::integral_constant<BlockLayoutMethod, M>())` where M is `method`
+ */
+template <typename Fn>
+void DispatchBlockLayoutMethod(BlockLayoutMethod method, Fn &&fn) {
+    switch (method) {
+    case BlockLayoutMethod::ColumnMajor:
+        fn(std::integral_constant<BlockLayoutMethod, BlockLayoutMethod::ColumnMajor>());
+        return;
+    case BlockLayoutMethod::Hilbert:
+        fn(std::integral_constant<BlockLayoutMethod, BlockLayoutMethod::Hilbert>());
+        return;
+    case BlockLayoutMethod::ColumnMajorZigZag:
+        fn(std::integral_constant<BlockLayoutMethod, BlockLayoutMethod::ColumnMajorZigZag>());
+        return;
+    case BlockLayoutMethod::ColumnMajorReverse:
+        fn(std::integral_constant<BlockLayoutMethod, BlockLayoutMethod::ColumnMajorReverse>());
+        return;
+    case BlockLayoutMethod::Morton:
+        fn(std::integral_constant<BlockLayoutMethod, BlockLayoutMethod::Morton>());
+        return;
+    }
+
+    throw UnknownBlockLayoutMethodError(method);
+}
+
+/**
+ * @brief Converts `addresses` to `coordinates` using `Method`
+ */
+template <typename ExecutionSpace, typename MemorySpace, BlockLayoutMethod Method>
+void GetBlockCoordinatesWith(BlockLayoutMap<MemorySpace> const &map,
+                             typename BlockViews<MemorySpace>::addresses_type addresses,
+                             typename BlockViews<MemorySpace>::out_coordinates_type coordinates) {
+    Kokkos::parallel_for(
+        "eap::mesh::GetBlockCoordinates",
+        Kokkos::RangePolicy<ExecutionSpace>(0, addresses.extent(0)),
+        KOKKOS_LAMBDA(global_index_t const i) {
+            auto const coords = map.template GetCoordinates<Method>(addresses(i));
+            coordinates(i, 0) = coords.x;
+            coordinates(i, 1) = coords.y;
+            coordinates(i, 2) = coords.z;
+        });
+}
+
+/**
+ * @brief Converts `coordinates` to `addresses` using `Method`
+ */
+template <typename ExecutionSpace, typename MemorySpace, BlockLayoutMethod Method>
+void GetBlockAddressesWith(BlockLayoutMap<MemorySpace> const &map,
+                           typename BlockViews<MemorySpace>::coordinates_type coordinates,
+                           typename BlockViews<MemorySpace>::out_addresses_type addresses) {
+    Kokkos::parallel_for(
+        "eap::mesh::GetBlockAddresses",
+        Kokkos::RangePolicy<ExecutionSpace>(0, coordinates.extent(0)),
+        KOKKOS_LAMBDA(global_index_t const i) {
+            addresses(i) = map.template GetAddress<Method>(
+                coordinates(i, 0), coordinates(i, 1), coordinates(i, 2));
+        });
+}
+} // namespace internal
+} // namespace mesh
+} // namespace eap
+
+template <typename ExecutionSpace, typename MemorySpace>
+void eap::mesh::GetBlockCoordinates(
+    BlockLayout const &layout,
+    typename internal::BlockViews<MemorySpace>::addresses_type addresses,
+    typename internal::BlockViews<MemorySpace>::out_coordinates_type coordinates) {
+    if (coordinates.extent(0) < addresses.extent(0) || coordinates.extent(1) < 3) {
+        throw std::invalid_argument("GetBlockCoordinates: coordinates must be at least (" +
+                                    std::to_string(addresses.extent(0)) + ", 3).");
+    }
+
+    // Check the addresses up front since kernels can't throw
+    global_index_t max_address = 0;
+    Kokkos::parallel_reduce(
+        "eap::mesh::GetBlockCoordinates::max_address",
+        Kokkos::RangePolicy<ExecutionSpace>(0, addresses.extent(0)),
+        KOKKOS_LAMBDA(global_index_t const i, global_index_t &max) {
+            if (addresses(i) > max) max = addresses(i);
+        },
+        Kokkos::Max<global_index_t>(max_address));
+
+    if (addresses.extent(0) > 0 && max_address >= layout.size()) {
+        throw InvalidBlockAddressError(max_address, layout.size());
+    }
+
+    internal::BlockLayoutMap<MemorySpace> const map(layout);
+
+    internal::DispatchBlockLayoutMethod(layout.method(), [&](auto method) {
+        internal::GetBlockCoordinatesWith<ExecutionSpace, MemorySpace, decltype(method)::value>(
+            map, addresses, coordinates);
+    });
+
+    Kokkos::fence();
+}
+
+template <typename ExecutionSpace, typename MemorySpace>
+void eap::mesh::GetBlockAddresses(
+    BlockLayout const &layout,
+    typename internal::BlockViews<MemorySpace>::coordinates_type coordinates,
+    typename internal::BlockViews<MemorySpace>::out_addresses_type addresses) {
+    if (addresses.extent(0) < coordinates.extent(0) || coordinates.extent(1) < 3) {
+        throw std::invalid_argument("GetBlockAddresses: coordinates must be (n, 3) and addresses "
+                                    "must be at least n long.");
+    }
+
+    // Check the coordinates up front since kernels can't throw
+    auto const extents = layout.extents();
+    auto const imax = extents[0];
+    auto const jmax = extents[1];
+    auto const kmax = extents[2];
+    auto const num_blocks = coordinates.extent(0);
+    global_index_t first_invalid = num_blocks;
+    Kokkos::parallel_reduce(
+        "eap::mesh::GetBlockAddresses::first_invalid",
+        Kokkos::RangePolicy<ExecutionSpace>(0, num_blocks),
+        KOKKOS_LAMBDA(global_index_t const i, global_index_t &first) {
+            auto const valid =
+                coordinates(i, 0) < imax && coordinates(i, 1) < jmax && coordinates(i, 2) < kmax;
+            if (!valid && i < first) first = i;
+        },
+        Kokkos::Min<global_index_t>(first_invalid));
+
+    if (first_invalid < num_blocks) {
+        auto const invalid = Kokkos::subview(coordinates, first_invalid, Kokkos::ALL());
+        auto const invalid_host = Kokkos::create_mirror_view(invalid);
+        Kokkos::deep_copy(invalid_host, invalid);
+
+        throw InvalidBlockCoordinatesError(
+            BlockCoordinates{invalid_host(0), invalid_host(1), invalid_host(2)},
+            BlockCoordinates{extents[0], extents[1], extents[2]});
+    }
+
+    internal::BlockLayoutMap<MemorySpace> const map(layout);
+
+    internal::DispatchBlockLayoutMethod(layout.method(), [&](auto method) {
+        internal::GetBlockAddressesWith<ExecutionSpace, MemorySpace, decltype(method)::value>(
+            map, coordinates, addresses);
+    });
+
+    Kokkos::fence();
+}
+
+#endif // EAP_MESH_BLOCKS_COMPUTE_HPP_
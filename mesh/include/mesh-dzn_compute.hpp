@@ -10,8 +10,13 @@
 #ifndef EAP_MESH_DZN_COMPUTE_HPP_
 #define EAP_MESH_DZN_COMPUTE_HPP_
 
+// STL Includes
+#include <string>
+#include <vector>
+
 // Internal Includes
 #include <utility-memory.hpp>
+#include <utility-optional_integer.hpp>
 
 // Local Includes
 #include <mesh-cells.hpp>
@@ -24,6 +29,8 @@ namespace mesh {
  * @brief
  *  Compute the level for each cell in the range [llow,lhigh) by applying the DZN regions in `dzn`.
  *
+ * @tparam ExecutionSpace
+ *  Where to test the cells. Must be able to access `cells.cell_center()`
  * @tparam FilterFn
  *  Type of functor for filtering out DZNs. Runs on host
  * @param dzn
@@ -44,7 +51,7 @@ namespace mesh {
  * @param filter
  *  Filtering function for DZNs
  */
-template <typename FilterFn>
+template <typename ExecutionSpace = Kokkos::DefaultExecutionSpace, typename FilterFn = void>
 void ProcessCellsInDZNWithFilter(
     DefinedZoneResolutionInfo const &dzn,
     std::uint8_t numdim,
@@ -192,6 +199,179 @@ nonstd::optional<eap::local_index_t> SplitDZNFilterKode(DefinedZoneResolutionInf
                                                         Coordinates<double> test,
                                                         local_index_t level_base);
 
+namespace internal {
+/**
+ * @brief View types of the array DZN API in `MemorySpace`.
+ *
+ * @details
+ *  Naming the views through a nested type keeps `MemorySpace` from being deduced from the
+ *  arguments, so callers can pass any view that converts to them.
+ */
+template <typename MemorySpace>
+struct DZNViews {
+    using points_type = Kokkos::View<double const **, Kokkos::LayoutStride, MemorySpace>;
+    using found_type = Kokkos::View<utility::OptionalInteger<local_index_t> *, MemorySpace>;
+    using level_base_type = Kokkos::View<local_index_t const *, MemorySpace>;
+    using level_set_type = Kokkos::View<local_index_t *, MemorySpace>;
+};
+} // namespace internal
+
+/**
+ * @brief Coordinates of a set of test points in `MemorySpace`. The first index is the point and
+ * the second is the dimension.
+ */
+template <typename MemorySpace = eap::HostMemorySpace>
+using DZNPointsView = typename internal::DZNViews<MemorySpace>::points_type;
+
+/**
+ * @brief Coordinates of a set of test points on the host.
+ */
+using DZNPoints = DZNPointsView<>;
+
+/**
+ * @brief Determine which DZN applies at each point in `points`.
+ *
+ * @details
+ *  Same as FindDZNWithFilter, but evaluates the DZNs once and tests all of the points in one
+ *  parallel kernel.
+ *
+ * @tparam ExecutionSpace
+ *  Where to test the points
+ * @tparam MemorySpace
+ *  Where `points` and `found` live. Must be accessible from `ExecutionSpace`
+ * @tparam FilterFn
+ *  Type of the Filter function (typically a lambda). Runs on host
+ * @param dzn
+ *  DZN Properties
+ * @param numdim
+ *  Number of dimensions of current run
+ * @param time
+ *  Elapsed time
+ * @param points
+ *  Points to check
+ * @param found
+ *  Output array, set to the index of the matching DZN or nullint for each point
+ * @param filter
+ *  A check on DZNs to decide whether it should be applied.
+ */
+template <typename ExecutionSpace = Kokkos::DefaultExecutionSpace,
+          typename MemorySpace = eap::HostMemorySpace,
+          typename FilterFn = void>
+void FindDZNsWithFilter(DefinedZoneResolutionInfo const &dzn,
+                        std::uint8_t numdim,
+                        double time,
+                        DZNPointsView<MemorySpace> points,
+                        typename internal::DZNViews<MemorySpace>::found_type found,
+                        FilterFn filter);
+
+/**
+ * @brief Determine which DZN applies at each point in `points`.
+ *
+ * @param dzn
+ *  DZN Properties
+ * @param numdim
+ *  Number of dimensions of current run
+ * @param time
+ *  Elapsed time
+ * @param points
+ *  Points to check
+ * @param found
+ *  Output array, set to the index of the matching DZN or nullint for each point
+ */
+void FindDZNs(DefinedZoneResolutionInfo const &dzn,
+              std::uint8_t numdim,
+              double time,
+              DZNPoints points,
+              Kokkos::View<utility::OptionalInteger<local_index_t> *, eap::HostMemorySpace> found);
+
+/**
+ * @brief Determine what level we need to split cells at each point in `points`.
+ *
+ * @details
+ *  Same as SplitDZNWithFilter, but evaluates the DZNs once and tests all of the points in one
+ *  parallel kernel. `level_set(i)` is only written if a DZN sets a level at point `i`.
+ *
+ * @tparam ExecutionSpace
+ *  Where to test the points
+ * @tparam MemorySpace
+ *  Where `points`, `level_base` and `level_set` live. Must be accessible from `ExecutionSpace`
+ * @tparam FilterFn
+ *  Type of the Filter function (typically a lambda). Runs on host
+ * @param dzn
+ *  DZN Properties
+ * @param numdim
+ *  Number of dimensions of current run
+ * @param time
+ *  Elapsed time
+ * @param points
+ *  Points to check
+ * @param level_base
+ *  The base level to add relative levels to, for each point
+ * @param level_set
+ *  Output array for levels, for each point
+ * @param filter
+ *  A check on DZNs to decide whether it should be applied.
+ */
+template <typename ExecutionSpace = Kokkos::DefaultExecutionSpace,
+          typename MemorySpace = eap::HostMemorySpace,
+          typename FilterFn = void>
+void SplitDZNsWithFilter(DefinedZoneResolutionInfo const &dzn,
+                         std::uint8_t numdim,
+                         double time,
+                         DZNPointsView<MemorySpace> points,
+                         typename internal::DZNViews<MemorySpace>::level_base_type level_base,
+                         typename internal::DZNViews<MemorySpace>::level_set_type level_set,
+                         FilterFn filter);
+
+/**
+ * @brief Determine what level we need to split cells at each point in `points`.
+ *
+ * @param dzn
+ *  DZN Properties
+ * @param numdim
+ *  Number of dimensions of current run
+ * @param time
+ *  Elapsed time
+ * @param points
+ *  Points to check
+ * @param level_base
+ *  The base level to add relative levels to, for each point
+ * @param level_set
+ *  Output array for levels, for each point
+ */
+void SplitDZNs(DefinedZoneResolutionInfo const &dzn,
+               std::uint8_t numdim,
+               double time,
+               DZNPoints points,
+               Kokkos::View<local_index_t const *, eap::HostMemorySpace> level_base,
+               Kokkos::View<local_index_t *, eap::HostMemorySpace> level_set);
+
+/**
+ * @brief Determine what level we need to split cells at each point in `points`.
+ *
+ * @param dzn
+ *  DZN Properties
+ * @param numdim
+ *  Number of dimensions of current run
+ * @param time
+ *  Elapsed time
+ * @param kode
+ *  What kode the DZN must have to match.
+ * @param points
+ *  Points to check
+ * @param level_base
+ *  The base level to add relative levels to, for each point
+ * @param level_set
+ *  Output array for levels, for each point
+ */
+void SplitDZNsFilterKode(DefinedZoneResolutionInfo const &dzn,
+                         std::uint8_t numdim,
+                         double time,
+                         Kode kode,
+                         DZNPoints points,
+                         Kokkos::View<local_index_t const *, eap::HostMemorySpace> level_base,
+                         Kokkos::View<local_index_t *, eap::HostMemorySpace> level_set);
+
 /**
  * @brief
  *  Compute the level for each cell in the range [llow,lhigh) by applying the DZN regions in `dzn`.
@@ -308,21 +488,451 @@ KOKKOS_INLINE_FUNCTION bool InRange(Kokkos::pair<double, double> const &range, d
     return test >= range.first && test <= range.second;
 }
 
-void ProcessCellsInDZN(DefinedZoneResolutionInfo const &dzn,
-                       size_t n,
+/**
+ * @brief Raises an error if DZNs of shape `use` aren't supported in `numdim` dimensions
+ */
+void CheckZoneShape(ZoneShape use, std::uint8_t numdim);
+
+/**
+ * @brief Copies `view` into `MemorySpace`, or returns it if it already lives there
+ */
+template <typename MemorySpace, typename ViewType>
+auto MirrorViewTo(ViewType const &view) {
+    auto mirror = Kokkos::create_mirror_view(MemorySpace(), view);
+    Kokkos::deep_copy(mirror, view);
+    return mirror;
+}
+
+/// Columns of CompiledDZNArrays::geometry
+enum DZNField : int {
+    START_X = 0,
+    END_X = 3,
+    AXIS_X = 6,
+    R_START = 9,
+    R_DELTA,
+    R_LOWER_SQUARED,
+    R_UPPER_SQUARED,
+    INV_AXIS_SQUARED,
+    NUM_DZN_FIELDS
+};
+
+/**
+ * @brief The arrays of a set of compiled DZNs, in `MemorySpace`
+ */
+template <typename MemorySpace>
+struct CompiledDZNArrays {
+    Kokkos::View<local_index_t *, MemorySpace> index;
+    Kokkos::View<ZoneOptions *, MemorySpace> options;
+    Kokkos::View<local_diff_t *, MemorySpace> level;
+
+    /// False for cones and cylinders whose geometry can't match any point
+    Kokkos::View<bool *, MemorySpace> valid;
+
+    /// Column f holds DZNField f of every DZN
+    Kokkos::View<double **, Kokkos::LayoutLeft, MemorySpace> geometry;
+
+    /** @brief Copies the arrays into `OtherSpace`, sharing them if they're already there */
+    template <typename OtherSpace>
+    CompiledDZNArrays<OtherSpace> MirrorTo() const {
+        CompiledDZNArrays<OtherSpace> mirror;
+        mirror.index = MirrorViewTo<OtherSpace>(index);
+        mirror.options = MirrorViewTo<OtherSpace>(options);
+        mirror.level = MirrorViewTo<OtherSpace>(level);
+        mirror.valid = MirrorViewTo<OtherSpace>(valid);
+        mirror.geometry = MirrorViewTo<OtherSpace>(geometry);
+        return mirror;
+    }
+};
+
+/**
+ * @brief A single DZN evaluated at a point in time, with the same fields as one entry of
+ * CompiledDZNArrays
+ */
+struct CompiledDZN {
+    ZoneOptions options;
+    local_diff_t level;
+    bool valid;
+    double geometry[NUM_DZN_FIELDS];
+};
+
+/**
+ * @brief Evaluates DZN `n` from `dzn` at `time`. Doesn't allocate.
+ */
+CompiledDZN CompileDZN(DefinedZoneResolutionInfo const &dzn,
                        std::uint8_t numdim,
-                       Cells const &cells,
                        double time,
-                       local_index_t llow,
-                       local_index_t lhigh,
-                       Kokkos::View<local_index_t const *, eap::HostMemorySpace> level_base,
-                       Kokkos::View<local_index_t *> lbuf,
-                       Kokkos::View<local_index_t *, eap::HostMemorySpace> level_set);
+                       local_index_t n);
+
+/**
+ * @brief Tests whether a compiled DZN applies to the point `test`, taking `outer` into account
+ *
+ * @tparam GeometryFn (DZNField f) -> double, the field f of the DZN
+ */
+template <typename GeometryFn>
+KOKKOS_INLINE_FUNCTION bool ZoneMatches(ZoneOptions const &options,
+                                        bool valid,
+                                        std::uint8_t numdim,
+                                        GeometryFn const &geometry,
+                                        Coordinates<double> const &test) {
+    using eap::utility::Square;
+
+    double const point[3] = {test.x, test.y, test.z};
+
+    bool inside = false;
+    switch (options.use) {
+    case ZoneShape::BricksAndRectangles: {
+        // NOTE: The original Fortran code also checked the yrange for 1D tests, which seemed
+        // pretty nonsensical.
+        inside = true;
+        for (int d = 0; d < numdim; d++) {
+            inside = inside && point[d] >= geometry(START_X + d) && point[d] <= geometry(END_X + d);
+        }
+        break;
+    }
+    case ZoneShape::SpheresAndCircles: {
+        double rsqr = 0.0;
+        for (int d = 0; d < numdim; d++) {
+            rsqr += Square(point[d] - geometry(START_X + d));
+        }
+        inside = rsqr >= geometry(R_LOWER_SQUARED) && rsqr <= geometry(R_UPPER_SQUARED);
+        break;
+    }
+    case ZoneShape::ConesAndWedges:
+    case ZoneShape::Cylinder: {
+        if (!valid) return false;
+
+        // Project the point onto the axis, then measure its distance from the axis
+        double offset[3] = {0.0, 0.0, 0.0};
+        double s = 0.0;
+        for (int d = 0; d < numdim; d++) {
+            offset[d] = point[d] - geometry(START_X + d);
+            s += geometry(AXIS_X + d) * offset[d];
+        }
+        s *= geometry(INV_AXIS_SQUARED);
+
+        double rsqr = 0.0;
+        for (int d = 0; d < numdim; d++) {
+            rsqr += Square(s * geometry(AXIS_X + d) - offset[d]);
+        }
+
+        if (options.use == ZoneShape::ConesAndWedges) {
+            auto const rtest = Square(geometry(R_START) + s * geometry(R_DELTA));
+            inside = s >= 0.0 && s <= 1.0 && rsqr <= rtest;
+        } else {
+            inside = s >= 0.0 && s <= 1.0 && rsqr >= geometry(R_LOWER_SQUARED) &&
+                     rsqr <= geometry(R_UPPER_SQUARED);
+        }
+        break;
+    }
+    }
+
+    return inside == !options.outer;
+}
+
+/**
+ * @brief Evaluates the DZNs `selected` from `dzn` at `time`, in order
+ */
+CompiledDZNArrays<eap::HostMemorySpace> CompileDZNs(DefinedZoneResolutionInfo const &dzn,
+                                                    std::uint8_t numdim,
+                                                    double time,
+                                                    std::vector<local_index_t> const &selected);
+
+/**
+ * @brief Gets a box holding every point compiled DZN `k` can match. Unbounded dimensions extend
+ * to infinity.
+ */
+void GetZoneBounds(CompiledDZNArrays<eap::HostMemorySpace> const &zones,
+                   std::uint8_t numdim,
+                   local_index_t k,
+                   Kokkos::Array<double, 3> &lo,
+                   Kokkos::Array<double, 3> &hi);
+} // namespace internal
+
+/**
+ * @brief A set of DZNs compiled for one point in time.
+ *
+ * @details
+ *  Holds the DZNs that passed a filter, in priority order, with their options decoded and their
+ *  geometry evaluated at `time`. The geometry is stored as structure-of-arrays: column f of
+ *  the geometry array holds field f of every DZN contiguously, along with the squared radii and
+ *  inverse axis lengths the shape tests need.
+ *
+ *  The DZNs are always compiled on the host. If `MemorySpace` isn't host accessible, the arrays
+ *  are copied into it once and the host arrays are kept for building the ZoneGrid.
+ *
+ * @tparam MemorySpace
+ *  Where Matches and ApplyLevel read the compiled DZNs from
+ */
+template <typename MemorySpace = eap::HostMemorySpace>
+class CompiledDZNs {
+  public:
+    using memory_space = MemorySpace;
+
+    /**
+     * @brief Compiles the DZNs in `dzn` that pass `filter` at `time`
+     *
+     * @tparam FilterFn (local_index_t n, ZoneOptions options) -> bool. Runs on host
+     */
+    template <typename FilterFn>
+    CompiledDZNs(DefinedZoneResolutionInfo const &dzn,
+                 std::uint8_t numdim,
+                 double time,
+                 FilterFn filter);
+
+    /** @brief Number of compiled DZNs */
+    KOKKOS_INLINE_FUNCTION local_index_t size() const { return num_zones_; }
+
+    /** @brief Number of dimensions the DZNs were compiled for */
+    KOKKOS_INLINE_FUNCTION std::uint8_t numdim() const { return numdim_; }
+
+    /** @brief Index in the original DefinedZoneResolutionInfo of compiled DZN `k` */
+    KOKKOS_INLINE_FUNCTION local_index_t Index(local_index_t k) const { return arrays_.index(k); }
+
+    /** @brief Decoded options of compiled DZN `k` */
+    KOKKOS_INLINE_FUNCTION ZoneOptions const &Options(local_index_t k) const {
+        return arrays_.options(k);
+    }
+
+    /** @brief The compiled arrays on the host */
+    internal::CompiledDZNArrays<eap::HostMemorySpace> const &HostArrays() const {
+        return host_arrays_;
+    }
+
+    /**
+     * @brief Gets a box holding every point compiled DZN `k` can match. Unbounded dimensions
+     * extend to infinity. Runs on host.
+     */
+    void GetBounds(local_index_t k,
+                   Kokkos::Array<double, 3> &lo,
+                   Kokkos::Array<double, 3> &hi) const {
+        internal::GetZoneBounds(host_arrays_, numdim_, k, lo, hi);
+    }
+
+    /**
+     * @brief Tests whether compiled DZN `k` applies to the point `test`, taking `outer` into
+     * account
+     */
+    KOKKOS_INLINE_FUNCTION bool Matches(local_index_t k, Coordinates<double> const &test) const;
+
+    /**
+     * @brief Sets `level_set` to the level requested by compiled DZN `k`, if it requests one
+     */
+    KOKKOS_INLINE_FUNCTION void
+    ApplyLevel(local_index_t k, local_index_t level_base, local_index_t &level_set) const;
+
+  private:
+    std::uint8_t numdim_;
+    local_index_t num_zones_;
+
+    internal::CompiledDZNArrays<MemorySpace> arrays_;
+    internal::CompiledDZNArrays<eap::HostMemorySpace> host_arrays_;
+};
+
+namespace internal {
+/**
+ * @brief A uniform grid over a set of points that lists, for each bin, the DZNs that can match a
+ * point in that bin
+ */
+template <typename MemorySpace>
+struct ZoneGrid {
+    /** @brief Lower corner of the grid */
+    Kokkos::Array<double, 3> lo;
+    /** @brief Inverse of the bin width in each dimension */
+    Kokkos::Array<double, 3> inv_width;
+    /** @brief Number of bins in each dimension */
+    Kokkos::Array<local_index_t, 3> num_bins;
+
+    /**
+     * @brief The candidate DZNs of bin b are bin_zones(bin_offset(b)) to
+     * bin_zones(bin_offset(b + 1) - 1), in increasing priority
+     */
+    Kokkos::View<local_index_t *, MemorySpace> bin_offset;
+    Kokkos::View<local_index_t *, MemorySpace> bin_zones;
+
+    /** @brief Gets the bin index of the coordinate `x` in dimension `dim` */
+    KOKKOS_INLINE_FUNCTION local_index_t BinOf(int dim, double x) const {
+        auto const i = (x - lo[dim]) * inv_width[dim];
+        if (!(i > 0.0)) return 0;
+        if (i >= num_bins[dim]) return num_bins[dim] - 1;
+        return static_cast<local_index_t>(i);
+    }
+
+    /** @brief Gets the bin holding `test` */
+    KOKKOS_INLINE_FUNCTION local_index_t Bin(Coordinates<double> const &test) const {
+        return BinOf(0, test.x) +
+               num_bins[0] * (BinOf(1, test.y) + num_bins[1] * BinOf(2, test.z));
+    }
+
+    /** @brief Copies the grid into `OtherSpace`, sharing its lists if they're already there */
+    template <typename OtherSpace>
+    ZoneGrid<OtherSpace> MirrorTo() const {
+        ZoneGrid<OtherSpace> mirror;
+        mirror.lo = lo;
+        mirror.inv_width = inv_width;
+        mirror.num_bins = num_bins;
+        mirror.bin_offset = MirrorViewTo<OtherSpace>(bin_offset);
+        mirror.bin_zones = MirrorViewTo<OtherSpace>(bin_zones);
+        return mirror;
+    }
+};
+
+/**
+ * @brief Lists the DZNs in `zones` that overlap each bin of a grid over the box starting at `lo`
+ * with size `extent`, holding `num_points` points.
+ *
+ * @details
+ *  A DZN is listed in a bin if its bounding box overlaps the bin. Outer DZNs can match anywhere,
+ *  so they're listed in every bin.
+ */
+ZoneGrid<eap::HostMemorySpace> BinZones(CompiledDZNArrays<eap::HostMemorySpace> const &zones,
+                                        std::uint8_t numdim,
+                                        Kokkos::Array<double, 3> const &lo,
+                                        Kokkos::Array<double, 3> const &extent,
+                                        local_index_t num_points);
+
+/**
+ * @brief Bins the points in [low, high) and lists the DZNs in `zones` that overlap each bin.
+ *
+ * @details
+ *  The bounds of the points are reduced in `ExecutionSpace`, the bins are filled on the host and
+ *  then copied into `MemorySpace`.
+ */
+template <typename ExecutionSpace, typename MemorySpace>
+ZoneGrid<MemorySpace> BuildZoneGrid(CompiledDZNs<MemorySpace> const &zones,
+                                    DZNPointsView<MemorySpace> points,
+                                    local_index_t low,
+                                    local_index_t high) {
+    EE_DIAG_PRE
+
+    EE_ASSERT(high > low);
+
+    Kokkos::Array<double, 3> lo{0.0, 0.0, 0.0};
+    Kokkos::Array<double, 3> extent{0.0, 0.0, 0.0};
+
+    for (int d = 0; d < zones.numdim(); d++) {
+        Kokkos::MinMaxScalar<double> range;
+        Kokkos::parallel_reduce(
+            "eap::mesh::internal::BuildZoneGrid::point_bounds",
+            Kokkos::RangePolicy<ExecutionSpace>(low, high),
+            KOKKOS_LAMBDA(local_index_t const i, Kokkos::MinMaxScalar<double> &range) {
+                auto const x = points(i, d);
+                if (x < range.min_val) range.min_val = x;
+                if (x > range.max_val) range.max_val = x;
+            },
+            Kokkos::MinMax<double>(range));
+
+        lo[d] = range.min_val;
+        extent[d] = range.max_val - range.min_val;
+    }
+
+    return BinZones(zones.HostArrays(), zones.numdim(), lo, extent, high - low)
+        .template MirrorTo<MemorySpace>();
+
+    EE_DIAG_POST
+}
+
+/**
+ * @brief Calls `match(i, k)` for each point i in [low, high), where k is the final compiled DZN in
+ * `zones` that matches it or nullint if none do, in parallel in `ExecutionSpace`.
+ */
+template <typename ExecutionSpace, typename MemorySpace, typename MatchFn>
+void ForEachFinalMatch(std::string const &label,
+                       CompiledDZNs<MemorySpace> const &zones,
+                       DZNPointsView<MemorySpace> points,
+                       local_index_t low,
+                       local_index_t high,
+                       MatchFn match) {
+    if (high <= low) return;
+
+    auto const numdim = zones.numdim();
+
+    // Only test each point against the DZNs whose bounds overlap the point's bin
+    auto const grid = BuildZoneGrid<ExecutionSpace>(zones, points, low, high);
+
+    // Each point is loaded once and walks its candidate DZNs from last to first
+    Kokkos::parallel_for(
+        label,
+        Kokkos::RangePolicy<ExecutionSpace>(low, high),
+        KOKKOS_LAMBDA(local_index_t const i) {
+            Coordinates<double> test;
+            test.x = points(i, X_DIR);
+            if (numdim >= 2) test.y = points(i, Y_DIR);
+            if (numdim == 3) test.z = points(i, Z_DIR);
+
+            auto const bin = grid.Bin(test);
+
+            auto j = grid.bin_offset(bin + 1);
+            while (j-- > grid.bin_offset(bin)) {
+                auto const k = grid.bin_zones(j);
+                if (zones.Matches(k, test)) {
+                    match(i, utility::OptionalInteger<local_index_t>(k));
+                    return;
+                }
+            }
+
+            match(i, utility::OptionalInteger<local_index_t>(utility::nullint));
+        });
+
+    Kokkos::fence();
+}
 } // namespace internal
 } // namespace mesh
 } // namespace eap
 
+template <typename MemorySpace>
 template <typename FilterFn>
+eap::mesh::CompiledDZNs<MemorySpace>::CompiledDZNs(DefinedZoneResolutionInfo const &dzn,
+                                                   std::uint8_t numdim,
+                                                   double time,
+                                                   FilterFn filter)
+    : numdim_(numdim), num_zones_(0) {
+    std::vector<local_index_t> selected;
+    selected.reserve(dzn.numdzn);
+
+    for (local_index_t n = 0; n < dzn.numdzn; n++) {
+        auto const options = dzn.options(n).GetOptions();
+        if (!filter(n, options)) continue;
+
+        internal::CheckZoneShape(options.use, numdim);
+        selected.push_back(n);
+    }
+
+    num_zones_ = selected.size();
+    host_arrays_ = internal::CompileDZNs(dzn, numdim, time, selected);
+    arrays_ = host_arrays_.template MirrorTo<MemorySpace>();
+}
+
+template <typename MemorySpace>
+KOKKOS_INLINE_FUNCTION bool
+eap::mesh::CompiledDZNs<MemorySpace>::Matches(local_index_t k,
+                                              Coordinates<double> const &test) const {
+    auto const &geometry = arrays_.geometry;
+    return internal::ZoneMatches(
+        arrays_.options(k),
+        arrays_.valid(k),
+        numdim_,
+        [&geometry, k](int const f) { return geometry(k, f); },
+        test);
+}
+
+template <typename MemorySpace>
+KOKKOS_INLINE_FUNCTION void
+eap::mesh::CompiledDZNs<MemorySpace>::ApplyLevel(local_index_t k,
+                                                 local_index_t level_base,
+                                                 local_index_t &level_set) const {
+    auto const level = arrays_.level(k);
+
+    if (arrays_.options(k).add) {
+        if (level != 0) {
+            local_diff_t const relative = static_cast<local_diff_t>(level_base) + level;
+            level_set = relative > 1 ? static_cast<local_index_t>(relative) : local_index_t(1);
+        }
+    } else if (level > 0) {
+        level_set = static_cast<local_index_t>(level);
+    }
+}
+
+template <typename ExecutionSpace, typename FilterFn>
 void eap::mesh::ProcessCellsInDZNWithFilter(
     DefinedZoneResolutionInfo const &dzn,
     std::uint8_t numdim,
@@ -333,25 +943,82 @@ void eap::mesh::ProcessCellsInDZNWithFilter(
     Kokkos::View<local_index_t const *, eap::HostMemorySpace> level_base,
     Kokkos::View<local_index_t *, eap::HostMemorySpace> level_set,
     FilterFn filter) {
-    using namespace internal;
+    EE_DIAG_PRE
 
-    using eap::utility::Square;
-    using eap::utility::SquarePair;
+    // Compile the DZNs that pass the filter once, keeping them in priority order. They're
+    // compiled into the same space as the cell centers.
+    CompiledDZNs<eap::HostMemorySpace> const zones(dzn, numdim, time, filter);
+    if (zones.size() == 0) return;
 
+    // Each cell takes the level of the final DZN that matches its center
+    internal::ForEachFinalMatch<ExecutionSpace>(
+        "eap::mesh::ProcessCellsInDZNWithFilter",
+        zones,
+        cells.cell_center(),
+        llow,
+        lhigh,
+        KOKKOS_LAMBDA(local_index_t const l, utility::OptionalInteger<local_index_t> const k) {
+            if (k) zones.ApplyLevel(*k, level_base(l), level_set(l));
+        });
+
+    EE_DIAG_POST
+}
+
+template <typename ExecutionSpace, typename MemorySpace, typename FilterFn>
+void eap::mesh::FindDZNsWithFilter(DefinedZoneResolutionInfo const &dzn,
+                                   std::uint8_t numdim,
+                                   double time,
+                                   DZNPointsView<MemorySpace> points,
+                                   typename internal::DZNViews<MemorySpace>::found_type found,
+                                   FilterFn filter) {
     EE_DIAG_PRE
 
-    Kokkos::View<local_index_t *> lbuf("eap::mesh::ProcessCellsInDZNWithFilter::lbuf",
-                                       lhigh - llow);
+    EE_ASSERT(found.extent(0) >= points.extent(0));
 
-    for (local_index_t n = 0; n < dzn.numdzn; n++) {
-        auto options = dzn.options(n).GetOptions();
-        if (!filter(n, options)) continue;
+    CompiledDZNs<MemorySpace> const zones(dzn, numdim, time, filter);
 
-        internal::ProcessCellsInDZN(
-            dzn, n, numdim, cells, time, llow, lhigh, level_base, lbuf, level_set);
-    }
+    internal::ForEachFinalMatch<ExecutionSpace>(
+        "eap::mesh::FindDZNsWithFilter",
+        zones,
+        points,
+        0,
+        points.extent(0),
+        KOKKOS_LAMBDA(local_index_t const i, utility::OptionalInteger<local_index_t> const k) {
+            if (k) {
+                found(i) = zones.Index(*k);
+            } else {
+                found(i) = utility::nullint;
+            }
+        });
 
-    Kokkos::fence();
+    EE_DIAG_POST
+}
+
+template <typename ExecutionSpace, typename MemorySpace, typename FilterFn>
+void eap::mesh::SplitDZNsWithFilter(
+    DefinedZoneResolutionInfo const &dzn,
+    std::uint8_t numdim,
+    double time,
+    DZNPointsView<MemorySpace> points,
+    typename internal::DZNViews<MemorySpace>::level_base_type level_base,
+    typename internal::DZNViews<MemorySpace>::level_set_type level_set,
+    FilterFn filter) {
+    EE_DIAG_PRE
+
+    EE_ASSERT(level_base.extent(0) >= points.extent(0));
+    EE_ASSERT(level_set.extent(0) >= points.extent(0));
+
+    CompiledDZNs<MemorySpace> const zones(dzn, numdim, time, filter);
+
+    internal::ForEachFinalMatch<ExecutionSpace>(
+        "eap::mesh::SplitDZNsWithFilter",
+        zones,
+        points,
+        0,
+        points.extent(0),
+        KOKKOS_LAMBDA(local_index_t const i, utility::OptionalInteger<local_index_t> const k) {
+            if (k) zones.ApplyLevel(*k, level_base(i), level_set(i));
+        });
 
     EE_DIAG_POST
 }
@@ -363,167 +1030,28 @@ eap::mesh::FindDZNWithFilter(DefinedZoneResolutionInfo const &dzn,
                              double time,
                              Coordinates<double> test,
                              FilterFn filter) {
-    using namespace internal;
-
-    using eap::utility::Square;
-
     EE_DIAG_PRE
 
     // The original Fortran code counted up through the DZNs, ultimately the final applicable
     // DZN was applied. This code instead iterates backwards through the DZNs, breaking once a
     // match is found. The effect of the code should be the same, but this code will be slightly
-    // faster.
+    // faster. Each DZN is only evaluated once it's reached, without allocating, since this is
+    // called once per cell.
     auto n = dzn.numdzn;
     while (n-- > 0) {
-        auto options = dzn.options(n).GetOptions();
-
-        auto const use_inside = !options.outer;
+        auto const options = dzn.options(n).GetOptions();
         if (!filter(n, options)) continue;
 
-        auto const rrange = ApplyDeltas(dzn.radiuses(n), dzn.radius_deltas(n), time);
-        auto const xrange = ApplyDeltas(dzn.xs(n), dzn.x_deltas(n), time);
-        auto const yrange = ApplyDeltas(dzn.ys(n), dzn.y_deltas(n), time);
-        auto const zrange = ApplyDeltas(dzn.ys(n), dzn.y_deltas(n), time);
-
-        auto const drtest = rrange.second - rrange.first;
-        auto const dxtest = xrange.second - xrange.first;
-        auto const dytest = yrange.second - yrange.first;
-        auto const dztest = zrange.second - zrange.first;
-
-        if (options.use == ZoneShape::BricksAndRectangles) {
-            bool inside;
-            if (numdim == 3) {
-                inside =
-                    InRange(xrange, test.x) && InRange(yrange, test.y) && InRange(zrange, test.z);
-            } else if (numdim == 2) {
-                inside = InRange(xrange, test.x) && InRange(yrange, test.y);
-            } else {
-                // NOTE: The original Fortran code also checked the yrange here, which seemed pretty
-                // nonsensical to me for a 1D test.
-                inside = InRange(xrange, test.x);
-            }
-
-            if (inside == use_inside) {
-                return n;
-            }
-        } else if (options.use == ZoneShape::SpheresAndCircles) {
-            double rsqr;
-            if (numdim == 3) {
-                rsqr = Square(test.x - xrange.first) + Square(test.y - yrange.first) +
-                       Square(test.z - zrange.first);
-            } else if (numdim == 2) {
-                rsqr = Square(test.x - xrange.first) + Square(test.y - yrange.first);
-            } else {
-                rsqr = Square(test.x - xrange.first);
-            }
+        internal::CheckZoneShape(options.use, numdim);
 
-            auto const inside = (rrange.second > rrange.first)
-                                    ? rsqr >= Square(rrange.first) && rsqr <= Square(rrange.second)
-                                    : rsqr <= Square(rrange.first);
-
-            if (inside == use_inside) {
-                return n;
-            }
-        } else if (options.use == ZoneShape::ConesAndWedges) {
-            if (numdim == 3) {
-                auto const denom = Square(dxtest) + Square(dytest) + Square(dztest);
-
-                if (rrange.first >= 0.0 && rrange.second >= 0.0 && denom > 0.0) {
-                    auto const s =
-                        (dxtest * (test.x - xrange.first) + dytest * (test.y - yrange.first) +
-                         dztest * (test.z - zrange.first)) /
-                        denom;
-                    auto const rctest = rrange.first + s * drtest;
-                    auto const xctest = xrange.first + s * dxtest;
-                    auto const yctest = yrange.first + s * dytest;
-                    auto const zctest = zrange.first + s * dztest;
-
-                    auto const rtest = Square(rctest);
-
-                    auto const rsqr =
-                        Square(xctest - test.x) + Square(yctest - test.y) + Square(zctest - test.z);
-
-                    auto const inside = (s >= 0.0 && s <= 1.0 && rsqr <= rtest);
-                    if (inside == use_inside) {
-                        return n;
-                    }
-                }
-            } else if (numdim == 2) {
-                auto const denom = Square(dxtest) + Square(dytest);
-
-                if (rrange.first >= 0.0 && rrange.second >= 0.0 && denom > 0.0) {
-                    auto const s =
-                        (dxtest * (test.x - xrange.first) + dytest * (test.y - yrange.first)) /
-                        denom;
-                    auto const rctest = rrange.first + s * drtest;
-                    auto const xctest = xrange.first + s * dxtest;
-                    auto const yctest = yrange.first + s * dytest;
-
-                    auto const rtest = Square(rctest);
-
-                    auto const rsqr = Square(xctest - test.x) + Square(yctest - test.y);
-
-                    auto const inside = (s >= 0.0 && s <= 1.0 && rsqr <= rtest);
-                    if (inside == use_inside) {
-                        return n;
-                    }
-                }
-            } else {
-                EE_RAISE("typdzn 1st digit of 2 selected a ZoneShape::ConesAndWedges DZN for a "
-                         << numdim
-                         << "dimension problem. ConesAndWedges DZNs are only supported for 2D and "
-                            "3D problems.");
-            }
-        } else if (options.use == ZoneShape::Cylinder) {
-            if (numdim == 3) {
-                auto const denom = Square(dxtest) + Square(dytest) + Square(dztest);
-
-                if (rrange.first >= 0.0 && rrange.second > rrange.first && denom > 0.0) {
-                    auto const factor = 1.0 / denom;
-                    auto const s =
-                        (dxtest * (test.x - xrange.first) + dytest * (test.y - yrange.first) +
-                         dztest * (test.z - zrange.first)) *
-                        factor;
-                    auto const xctest = xrange.first + s * dxtest;
-                    auto const yctest = yrange.first + s * dytest;
-                    auto const zctest = zrange.first + s * dztest;
-
-                    auto const rsqr =
-                        Square(xctest - test.x) + Square(yctest - test.y) + Square(zctest - test.z);
-
-                    auto const inside = s >= 0.0 && s <= 1.0 && rsqr >= Square(rrange.first) &&
-                                        rsqr <= Square(rrange.second);
-
-                    if (inside == use_inside) {
-                        return n;
-                    }
-                }
-            } else if (numdim == 2) {
-                auto const denom = Square(dxtest) + Square(dytest);
-
-                if (rrange.first >= 0.0 && rrange.second > rrange.first && denom > 0.0) {
-                    auto const factor = 1.0 / denom;
-                    auto const s =
-                        (dxtest * (test.x - xrange.first) + dytest * (test.y - yrange.first)) *
-                        factor;
-                    auto const xctest = xrange.first + s * dxtest;
-                    auto const yctest = yrange.first + s * dytest;
-
-                    auto const rsqr = Square(xctest - test.x) + Square(yctest - test.y);
-
-                    auto const inside = s >= 0.0 && s <= 1.0 && rsqr >= Square(rrange.first) &&
-                                        rsqr <= Square(rrange.second);
-
-                    if (inside == use_inside) {
-                        return n;
-                    }
-                }
-            } else {
-                EE_RAISE("typdzn 1st digit of 3 selected a ZoneShape::Cylinder DZN for a "
-                         << numdim
-                         << "dimension problem. Cylinder DZNs are only supported for 2D and "
-                            "3D problems.");
-            }
+        auto const zone = internal::CompileDZN(dzn, numdim, time, n);
+        if (internal::ZoneMatches(
+                zone.options,
+                zone.valid,
+                numdim,
+                [&zone](int const f) { return zone.geometry[f]; },
+                test)) {
+            return n;
         }
     }
 
@@ -559,4 +1087,4 @@ eap::mesh::SplitDZNWithFilter(DefinedZoneResolutionInfo const &dzn,
     return nonstd::nullopt;
 }
 
-#endif // EAP_MESH_DZN_COMPUTE_HPP_
\ No newline at end of file
+#endif // EAP_MESH_DZN_COMPUTE_HPP_
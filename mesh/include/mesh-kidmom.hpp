@@ -12,9 +12,11 @@
 
 // STL Includes
 #include <cstddef>
+#include <memory>
 #include <utility>
 
 // Third Party Includes
+#include <mpi/mpi.hpp>
 #include <nonstd/optional.hpp>
 #include <nonstd/span.hpp>
 
@@ -37,6 +39,8 @@ struct KidMomOptions {
     bool mom_kid_use_s2s;
     /// Uses SomeToSome when initializing the mom_kids tokens
     bool mom_kids_use_s2s;
+    /// Builds a level-major cell renumbering in BuildPack
+    bool level_major_renumbering;
 };
 
 class KidMom {
@@ -69,7 +73,28 @@ class KidMom {
      */
     void InitializeLevel1();
 
-    std::pair<local_index_t, global_index_t> BuildTop(Cells const &cells);
+    /**
+     * @brief Collective. Compacts the local top cells into ltop_ and starts a non-blocking
+     * reduction of the global number of top cells.
+     *
+     * @details The reduction is completed by `WaitSumNumTop`, so callers can overlap it with
+     * local work such as `SetupAllTop`.
+     *
+     * @param cells Cells information
+     * @return local_index_t The number of local top cells
+     */
+    local_index_t BuildTop(Cells const &cells);
+
+    /**
+     * @brief Completes the reduction started by `BuildTop`, if any is still in-flight.
+     *
+     * @details Collective. Should be called before the KidMom is destroyed if `BuildTop` was
+     * called since the last call, e.g. by `Levels::SetupAllTop`. Otherwise the destructor, or the
+     * next `BuildTop`, completes the reduction.
+     *
+     * @return global_index_t The number of top cells on all ranks
+     */
+    global_index_t WaitSumNumTop();
 
     local_index_t SetupAllTop(Cells const &cells, local_index_t num_top);
 
@@ -164,14 +189,39 @@ class KidMom {
         return Kokkos::subview(lpoint_, Kokkos::make_pair(lopack(level), lopack(level + 1)));
     }
 
+    /**
+     * @brief Gets the first cell at `level` if the cells at `level` are a single run of
+     * consecutive cell indices.
+     *
+     * @param level Cell level
+     * @return The first cell at `level`, or nullopt if there are no cells at `level`, they aren't
+     * contiguous, or the segments are out-of-date.
+     */
+    nonstd::optional<local_index_t> ContiguousCellsAtLevel(local_index_t level) const {
+        if (!segments_valid_ || loseg_(level + 1) - loseg_(level) != 1) {
+            return nonstd::nullopt;
+        }
+
+        return local_index_t(lpoint_.view_host()(lseg_(loseg_(level))));
+    }
+
     void SetNumPack(local_index_t num_pack) { num_pack_ = num_pack; }
 
+    MeshView<FortranLocalIndex const *> RenumberNewToOld() const { return renumber_new_to_old_; }
+
+    MeshView<FortranLocalIndex const *> RenumberOldToNew() const { return renumber_old_to_new_; }
+
   private:
     /* Routines */
 
     void CheckLoHiPackAndLevels(Cells const &cells,
                                 MeshDualView<OptionalFortranLocalIndex *> cell_level);
 
+    void BuildSegments(MeshDualView<OptionalFortranLocalIndex *> cell_level_dual);
+
+    void BuildRenumbering(Cells const &cells,
+                          MeshDualView<OptionalFortranLocalIndex *> cell_level_dual);
+
     void ReconDivParent(Cells const &cells, local_index_t parentl, local_index_t childl) {
         cell_daughter_(parentl) = cells.cell_address()(childl);
     }
@@ -194,6 +244,21 @@ class KidMom {
 
     /* Data Members */
 
+    /// Global top cell count reduction started by BuildTop. Heap allocated so that the buffers
+    /// handed to MPI stay put while the request is in-flight. Only WaitSumNumTop completes it.
+    struct PendingTopSum {
+        global_index_t local = 0;
+        global_index_t global = 0;
+        MPI_Request request = MPI_REQUEST_NULL;
+    };
+
+    /// Completes a reduction that was never waited on before freeing its buffers, since a
+    /// non-blocking collective can't be freed or cancelled. After MPI_Finalize nothing can still
+    /// write to them, so they are freed directly.
+    struct PendingTopSumDeleter {
+        void operator()(PendingTopSum *pending) const noexcept;
+    };
+
     KidMomOptions options_;
 
     local_index_t num_pack_;
@@ -208,6 +273,11 @@ class KidMom {
 
     MeshView<FortranLocalIndex *> ltop_;
 
+    std::unique_ptr<PendingTopSum, PendingTopSumDeleter> pending_top_sum_;
+
+    /// Number of top cells on all ranks, as of the last completed BuildTop
+    global_index_t sum_num_top_ = 0;
+
     /// Number of real cells + ghost cells on this processor
     local_index_t all_num_top_ = 0;
 
@@ -219,6 +289,23 @@ class KidMom {
     /// Starting index for cells at this level in lpoint_
     MeshDualView<local_index_t *> lopack_;
 
+    /// Starting index in lseg_ for the segments at each level
+    MeshView<local_index_t *> loseg_;
+
+    /// Starting index in lpoint_ of each segment, a maximal run of lpoint_ at one level that holds
+    /// consecutive cell indices. lseg_(num_segments) is the total number of cells in lpoint_.
+    MeshView<local_index_t *> lseg_;
+
+    /// Segments are only in-sync with lpoint_ between BuildPack and ReconMove
+    bool segments_valid_ = false;
+
+    /// renumber_new_to_old_(i) is the current index of the cell that is placed at i by a
+    /// level-major renumbering. Only built if KidMomOptions::level_major_renumbering is set.
+    MeshView<FortranLocalIndex *> renumber_new_to_old_;
+
+    /// Inverse of renumber_new_to_old_
+    MeshView<FortranLocalIndex *> renumber_old_to_new_;
+
     /// Up to eap::mesh::MAX_LEVELS tokens
     std::vector<comm::Token> kid_token_;
 
@@ -19,6 +19,7 @@
 #include "mesh-constants.hpp"
 #include "mesh-dzn.hpp"
 #include "mesh-kidmom.hpp"
+#include "mesh-renumber.hpp"
 #include "mesh-types.hpp"
 
 namespace eap {
@@ -116,6 +117,9 @@ class Levels {
      * @brief Updates Levels' top level cell information (i.e. ltop) to address changes in cell
      * refinement.
      *
+     * @details Collective. The global count of top level cells is reduced asynchronously and
+     * completed by `SetupAllTop` or `SumNumTop`.
+     *
      * @param cells The associated `Cells` structure. Must pass this cells in all future calls to
      * levels.
      */
@@ -130,6 +134,14 @@ class Levels {
      */
     void SetupAllTop(Cells const &cells);
 
+    /**
+     * @brief Collective. Gets the number of top level cells on all ranks, completing the reduction
+     * started by `BuildTop` if it is still in-flight.
+     *
+     * @return global_index_t Number of top level cells on all ranks
+     */
+    global_index_t SumNumTop();
+
     /**
      * @brief Allocates communication patterns for exchanging information between cell mothers' and
      * their first child.
@@ -197,6 +209,43 @@ class Levels {
                    nonstd::span<FortranLocalIndex const> recv_start,
                    nonstd::span<local_index_t const> recv_length);
 
+    /**
+     * @brief Gets the level-major renumbering built by the last `BuildPack`
+     *
+     * @details Only built when `KidMomOptions::level_major_renumbering` is set. Cells are grouped
+     * by level, and keep their relative order within a level. Cells without a level are placed
+     * last.
+     *
+     * @return For each new cell index, the current index of the cell placed there
+     */
+    MeshView<FortranLocalIndex const *> RenumberNewToOld() const {
+        return kid_mom_.RenumberNewToOld();
+    }
+
+    /**
+     * @brief Gets the inverse of `RenumberNewToOld`
+     *
+     * @return For each current cell index, the new index of that cell
+     */
+    MeshView<FortranLocalIndex const *> RenumberOldToNew() const {
+        return kid_mom_.RenumberOldToNew();
+    }
+
+    /**
+     * @brief Permutes the local cells of `data` in-place to match the level-major renumbering
+     *
+     * @details Intended to be applied to every per-cell array during a recon, after which the
+     * cells at each level occupy a contiguous index range. As with any recon, `BuildPack` and the
+     * mother/daughter information must be rebuilt afterwards.
+     *
+     * @tparam View 1D or 2D host array type, indexed by cell in the first dimension
+     * @param data Array to renumber. Must have at least num_local_cells entries.
+     */
+    template <typename View>
+    void ApplyRenumbering(View const &data) const {
+        eap::mesh::ApplyRenumbering(kid_mom_.RenumberNewToOld(), data);
+    }
+
     /**
      * @brief Re-packs level information after a recon
      *
@@ -266,6 +315,9 @@ class Levels {
     /**
      * @brief Calls function for each cell at `level`
      *
+     * Walks the runs of consecutive cells found by BuildPack directly, and only reads the cell
+     * index list once per run.
+     *
      * @tparam Fn (local_index_t l) -> void
      * @param level cell level
      * @param function function to execute
@@ -275,6 +327,21 @@ class Levels {
         auto const lopack = kid_mom_.lopack_.view_host();
         auto const lpoint = kid_mom_.lpoint_.view_host();
 
+        if (kid_mom_.segments_valid_) {
+            auto const loseg = kid_mom_.loseg_;
+            auto const lseg = kid_mom_.lseg_;
+
+            for (auto s = loseg(level); s < loseg(level + 1); s++) {
+                local_index_t const first = lpoint(lseg(s));
+                local_index_t const last = first + (lseg(s + 1) - lseg(s));
+
+                for (auto l = first; l < last; l++) {
+                    function(l);
+                }
+            }
+            return;
+        }
+
         for (auto lp = lopack(level); lp < lopack(level + 1); lp++) {
             function(lpoint(lp));
         }
@@ -283,6 +350,9 @@ class Levels {
     /**
      * @brief Calls function for each cell at `level` in parallel
      *
+     * When the cells at `level` are contiguous, iterates over the cell range directly instead of
+     * through the cell index list.
+     *
      * @tparam ExecutionSpace The execution space to execute function in
      * @tparam MemorySapce The memory space of the cell index array
      * @tparam Fn (local_index_t l) -> void
@@ -297,6 +367,16 @@ class Levels {
                                 Fn function,
                                 std::string const &label = "Levels::ParallelForEachAtLevel") const {
         auto const lopack = kid_mom_.lopack_.view_host();
+
+        if (auto const first = kid_mom_.ContiguousCellsAtLevel(level)) {
+            Kokkos::parallel_for(
+                label,
+                Kokkos::RangePolicy<ExecutionSpace>(*first,
+                                                    *first + lopack(level + 1) - lopack(level)),
+                function);
+            return;
+        }
+
         auto const lpoint = kid_mom_.lpoint_.view<MemorySpace>();
 
         Kokkos::parallel_for(
@@ -364,9 +444,22 @@ class Levels {
             return num;
         } else {
             auto const lopack = kid_mom_.lopack_.view_host();
-            auto const lpoint = kid_mom_.lpoint_.view<MemorySpace>();
 
             local_index_t num = 0;
+            if (auto const first = kid_mom_.ContiguousCellsAtLevel(*level)) {
+                Kokkos::parallel_reduce(
+                    "Levels::CountFilterAtLevel[level >= 0, contiguous]",
+                    Kokkos::RangePolicy<ExecutionSpace>(
+                        *first, *first + lopack(*level + 1) - lopack(*level)),
+                    KOKKOS_LAMBDA(local_index_t l, local_index_t & num) {
+                        if (predicate(l)) ++num;
+                    },
+                    num);
+                return num;
+            }
+
+            auto const lpoint = kid_mom_.lpoint_.view<MemorySpace>();
+
             Kokkos::parallel_reduce(
                 "Levels::CountFilterAtLevel[level >= 0]",
                 Kokkos::RangePolicy<ExecutionSpace>(lopack(*level), lopack(*level + 1)),
@@ -379,40 +472,92 @@ class Levels {
     }
 
     /**
-     * @brief Filters cells matched by predicate into `out`
+     * @brief Filters cells matched by predicate into `out` in parallel
      *
+     * Evaluates predicate once per cell, then compacts the matched cells into `out` with a scan,
+     * so callers don't need a separate CountFilterAtLevel pass. Only the first `out.extent(0)`
+     * matched cells are written; callers that don't know the count up front can pass an `out` as
+     * large as the candidate set.
+     *
+     * @tparam ExecutionSpace The execution space to execute predicate in
+     * @tparam MemorySapce The memory space of the cell index array
      * @tparam OutView Output view type
      * @tparam Fn (local_index_t l) -> bool
      * @param level cell level
      * @param num_cell number of cells (only used if `level` is nullint)
      * @param out output view
      * @param predicate filter function
+     * @return local_index_t Number of cells that matched filter
      */
-    template <typename OutView, typename Fn>
-    void FilterAtLevel(utility::OptionalInteger<local_index_t> level,
-                       local_index_t num_cell,
-                       OutView out,
-                       Fn predicate) const {
+    template <typename ExecutionSpace = Kokkos::DefaultExecutionSpace,
+              typename MemorySpace = typename ExecutionSpace::memory_space,
+              typename OutView = void,
+              typename Fn = void>
+    local_index_t FilterAtLevel(utility::OptionalInteger<local_index_t> level,
+                                local_index_t num_cell,
+                                OutView out,
+                                Fn predicate) const {
+        local_index_t const out_size = out.extent(0);
+        local_index_t num = 0;
+
         if (!level) {
-            auto const cell_level = cell_level_.view_host();
+            auto const cell_level = cell_level_.view<MemorySpace>();
 
-            local_index_t n = 0;
-            for (local_index_t l = 0; l < num_cell; l++) {
-                if (!cell_level(l) && predicate(l)) {
-                    out(n++) = l;
-                }
-            }
+            Kokkos::View<bool *, MemorySpace> matched(
+                Kokkos::ViewAllocateWithoutInitializing("Levels::FilterAtLevel::matched"),
+                num_cell);
+
+            Kokkos::parallel_for(
+                "Levels::FilterAtLevel[level = nullint]::predicate",
+                Kokkos::RangePolicy<ExecutionSpace>(0, num_cell),
+                KOKKOS_LAMBDA(local_index_t const l) {
+                    matched(l) = !cell_level(l) && predicate(l);
+                });
+
+            Kokkos::parallel_scan(
+                "Levels::FilterAtLevel[level = nullint]::compact",
+                Kokkos::RangePolicy<ExecutionSpace>(0, num_cell),
+                KOKKOS_LAMBDA(local_index_t const l, local_index_t &update, bool const is_final) {
+                    if (matched(l)) {
+                        if (is_final && update < out_size) {
+                            out(update) = l;
+                        }
+                        update++;
+                    }
+                },
+                num);
         } else {
             auto const lopack = kid_mom_.lopack_.view_host();
-            auto const lpoint = kid_mom_.lpoint_.view_host();
-
-            local_index_t n = 0;
-            for (local_index_t lp = lopack(*level); lp < lopack(*level + 1); lp++) {
-                if (predicate(lpoint(lp))) {
-                    out(n++) = lp;
-                }
-            }
+            auto const lpoint = kid_mom_.lpoint_.view<MemorySpace>();
+            local_index_t const lp_low = lopack(*level);
+            local_index_t const lp_high = lopack(*level + 1);
+
+            Kokkos::View<bool *, MemorySpace> matched(
+                Kokkos::ViewAllocateWithoutInitializing("Levels::FilterAtLevel::matched"),
+                lp_high - lp_low);
+
+            Kokkos::parallel_for(
+                "Levels::FilterAtLevel[level >= 0]::predicate",
+                Kokkos::RangePolicy<ExecutionSpace>(lp_low, lp_high),
+                KOKKOS_LAMBDA(local_index_t const lp) {
+                    matched(lp - lp_low) = predicate(lpoint(lp));
+                });
+
+            Kokkos::parallel_scan(
+                "Levels::FilterAtLevel[level >= 0]::compact",
+                Kokkos::RangePolicy<ExecutionSpace>(lp_low, lp_high),
+                KOKKOS_LAMBDA(local_index_t const lp, local_index_t &update, bool const is_final) {
+                    if (matched(lp - lp_low)) {
+                        if (is_final && update < out_size) {
+                            out(update) = lpoint(lp);
+                        }
+                        update++;
+                    }
+                },
+                num);
         }
+
+        return num;
     }
 
     /**
@@ -428,17 +573,18 @@ class Levels {
     void CollectAtLevel(Cells const &cells,
                         utility::OptionalInteger<local_index_t> level,
                         View out) const {
-        EE_DIAG_PRE
+        EE_DIAG_PRE_DEBUG_IN(EAP_MESH_CHECK_LEVEL)
 
         if (!level) {
             EE_ASSERT(out.extent(0) >= cells.num_local_cells());
-            FilterAtLevel(0, cells.num_local_cells(), out, [](auto const) { return true; });
+            FilterAtLevel<Kokkos::DefaultHostExecutionSpace, eap::HostMemorySpace>(
+                0, cells.num_local_cells(), out, [](auto const) { return true; });
         } else {
             EE_ASSERT(out.extent(0) >= NumAtLevel(*level));
             Kokkos::deep_copy(out, CellsAtLevel(*level).view_host());
         }
 
-        EE_DIAG_POST
+        EE_DIAG_POST_DEBUG_IN(EAP_MESH_CHECK_LEVEL)
     }
 
     /**
@@ -494,6 +640,19 @@ class Levels {
         return kid_mom_.lopack_.view_host()(level + 1) - kid_mom_.lopack_.view_host()(level);
     }
 
+    /**
+     * @brief Get the number of chunks generated by the last `SetupAllTop`
+     *
+     * @details Contiguous runs of top cells are split into chunks of at most ELEM_MAX cells,
+     * followed by the clone cells in chunks of ELEM_MAX.
+     */
+    local_index_t ChunkCount() const { return chunk_count_; }
+
+    /**
+     * @brief Get the chunk of each top cell and clone cell, as of the last `SetupAllTop`
+     */
+    MeshView<FortranLocalIndex const *> ChunkIds() const { return chunk_ids_; }
+
     /**
      * @brief Set the flags of each cell to result of `function`.
      *
@@ -712,10 +871,6 @@ class Levels {
 
   private:
     /* Routines */
-    local_index_t CountChunks(Cells const &cells) const;
-
-    std::vector<std::array<local_index_t, 2>> PopulateChunks(Cells const &cells) const;
-
     struct GeneratedChunks {
         local_index_t chunk_count;
         MeshView<utility::FortranIndex<local_index_t> *> chunk_ids;
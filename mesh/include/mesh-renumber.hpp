@@ -0,0 +1,94 @@
+/**
+ * @file mesh-renumber.hpp
+ *
+ * @brief Permutes per-cell arrays into a new cell numbering
+ * @date 2019-09-20
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef EAP_MESH_RENUMBER_HPP_
+#define EAP_MESH_RENUMBER_HPP_
+
+// STL Includes
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// Third Party Includes
+#include <Kokkos_Core.hpp>
+
+// Internal Includes
+#include <error-macros.hpp>
+
+// Local Includes
+#include "mesh-types.hpp"
+
+namespace eap {
+namespace mesh {
+namespace internal {
+template <typename View, typename Range>
+auto RenumberSubview(View const &data, Range const &range)
+    -> std::enable_if_t<View::rank == 1, decltype(Kokkos::subview(data, range))> {
+    return Kokkos::subview(data, range);
+}
+
+template <typename View, typename Range>
+auto RenumberSubview(View const &data, Range const &range)
+    -> std::enable_if_t<View::rank == 2, decltype(Kokkos::subview(data, range, Kokkos::ALL))> {
+    return Kokkos::subview(data, range, Kokkos::ALL);
+}
+
+template <typename View, typename Copy>
+KOKKOS_INLINE_FUNCTION std::enable_if_t<View::rank == 1>
+RenumberRow(View const &data, Copy const &copy, local_index_t to, local_index_t from) {
+    data(to) = copy(from);
+}
+
+template <typename View, typename Copy>
+KOKKOS_INLINE_FUNCTION std::enable_if_t<View::rank == 2>
+RenumberRow(View const &data, Copy const &copy, local_index_t to, local_index_t from) {
+    for (size_t j = 0; j < data.extent(1); j++) {
+        data(to, j) = copy(from, j);
+    }
+}
+} // namespace internal
+
+/**
+ * @brief Permutes the first `new_to_old.extent(0)` cells of `data` in-place, so that new cell `i`
+ * holds what was cell `new_to_old(i)`
+ *
+ * @tparam View 1D or 2D host array type, indexed by cell in the first dimension
+ * @param new_to_old For each new cell index, the current index of that cell. Must be a
+ * permutation.
+ * @param data Array to renumber. Must have at least `new_to_old.extent(0)` entries.
+ */
+template <typename View>
+void ApplyRenumbering(MeshView<FortranLocalIndex const *> const &new_to_old, View const &data) {
+    static_assert(View::rank == 1 || View::rank == 2,
+                  "ApplyRenumbering only supports 1D and 2D arrays");
+
+    EE_DIAG_PRE
+
+    EE_ASSERT(data.extent(0) >= new_to_old.extent(0),
+              "data must have an entry for each renumbered cell");
+
+    auto const cells_range = std::make_pair(size_t(0), new_to_old.extent(0));
+    auto const cells_data = internal::RenumberSubview(data, cells_range);
+
+    auto copy = Kokkos::create_mirror(cells_data);
+    Kokkos::deep_copy(copy, cells_data);
+
+    Kokkos::parallel_for(
+        "eap::mesh::ApplyRenumbering",
+        Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, new_to_old.extent(0)),
+        KOKKOS_LAMBDA(local_index_t const i) {
+            internal::RenumberRow(cells_data, copy, i, new_to_old(i));
+        });
+
+    EE_DIAG_POST
+}
+} // namespace mesh
+} // namespace eap
+
+#endif // EAP_MESH_RENUMBER_HPP_
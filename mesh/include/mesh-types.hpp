@@ -20,9 +20,18 @@
 #include <Kokkos_DualView.hpp>
 
 // Internal Includes
+#include <error-levels.hpp>
 #include <utility-addressing.hpp>
 #include <utility-memory.hpp>
 
+/**
+ * @brief The eap-error check level of eap-mesh, and of its headers wherever they are included.
+ * Defined by CMake for eap-mesh and everything linking to it, see cmake/ErrorChecks.cmake.
+ */
+#ifndef EAP_MESH_CHECK_LEVEL
+#define EAP_MESH_CHECK_LEVEL EAP_ERROR_DEFAULT_CHECK_LEVEL
+#endif
+
 namespace eap {
 namespace mesh {
 
@@ -16,6 +16,7 @@
 #include <cstdint>
 #include <initializer_list>
 #include <numeric>
+#include <vector>
 
 // Third Party Includes
 #include <mpi/comm.hpp>
@@ -57,6 +58,7 @@ class MeshBuilder {
     rank_t num_extents_ = 0;
     std::array<global_index_t, 3> global_extents_{0, 0, 0};
     std::vector<double> rank_weights_;
+    BlockLayoutMethod block_layout_method_ = BlockLayoutMethod::ColumnMajor;
 
   public:
     static MeshBuilder from_comm(mpi::Comm *comm);
@@ -69,15 +71,36 @@ class MeshBuilder {
 
     std::array<global_index_t, 3> global_extents() const { return global_extents_; }
     std::array<global_index_t, 3> global_block_extents() const {
-        std::array<global_index_t, 3> block_extents{0, 0, 0};
-        for (auto i = 0; i < 3; i++) {
+        std::array<global_index_t, 3> block_extents{1, 1, 1};
+        for (auto i = 0; i < num_extents_; i++) {
             block_extents[i] = global_extents_[i] / 2;
         }
         return block_extents;
     }
 
+    /**
+     * @brief Sets the relative amount of work each rank should get. Ranks are given blocks in
+     * proportion to their weight. Without weights, blocks are split as evenly as possible.
+     *
+     * @param weights
+     *  One non-negative weight per rank of the Comm. At least one must be positive.
+     */
     void set_rank_weights(std::vector<double> &&weights);
 
+    /**
+     * @brief Sets the order blocks are laid out in before they're split across ranks.
+     */
+    void set_block_layout_method(BlockLayoutMethod method) { block_layout_method_ = method; }
+
+    /**
+     * @brief Splits the global blocks into consecutive runs of block addresses, one per rank.
+     *
+     * @return std::vector<global_index_t>
+     *  The first block address of each rank, followed by num_global_blocks(). Rank r owns the
+     *  blocks in [result[r], result[r + 1]).
+     */
+    std::vector<global_index_t> block_partition() const;
+
     void set_global_extents(std::initializer_list<global_index_t> list);
     void set_global_extents(global_index_t x) { set_global_extents({x}); }
     void set_global_extents(global_index_t x, global_index_t y) { set_global_extents({x, y}); }
@@ -93,16 +116,61 @@ class MeshBuilder {
  *
  */
 class Mesh {
+    friend class MeshBuilder;
+
     mpi::Comm comm_;
-    // std::uint8_t num_extents_ = 0;
+    std::uint8_t num_extents_ = 0;
+    std::array<global_index_t, 3> global_extents_{0, 0, 0};
+
+    /// Lower corner of the box holding the local cells
+    std::array<global_index_t, 3> local_lo_{0, 0, 0};
+    /// Size of the box holding the local cells
     std::array<local_index_t, 3> local_extents_{0, 0, 0};
 
+    /// First global cell address of each rank, followed by the number of global cells
+    std::vector<global_index_t> global_base_address_;
+
+    /// Global coordinates of each local cell
+    MeshView<global_index_t **> cell_coordinates_;
+
   public:
     static Mesh from_global_2d_dimensions(mpi::Comm *comm, global_index_t x, global_index_t y);
 
+    std::uint8_t num_extents() const { return num_extents_; }
+    std::array<global_index_t, 3> global_extents() const { return global_extents_; }
+
     local_index_t local_extent_0() const { return local_extents_[0]; }
     local_index_t local_extent_1() const { return local_extents_[1]; }
     local_index_t local_extent_2() const { return local_extents_[2]; }
+
+    /**
+     * @brief Returns the lower corner of the box holding the local cells, in global coordinates.
+     */
+    std::array<global_index_t, 3> local_lo() const { return local_lo_; }
+
+    /**
+     * @brief Returns the number of cells on this rank.
+     */
+    local_index_t num_local_cells() const { return cell_coordinates_.extent(0); }
+
+    /**
+     * @brief Returns the global address of the first local cell.
+     */
+    global_index_t global_base() const { return global_base_address_[comm_.rank()]; }
+
+    /**
+     * @brief Returns the first global cell address of each rank, followed by the number of global
+     * cells.
+     */
+    std::vector<global_index_t> const &global_base_address() const {
+        return global_base_address_;
+    }
+
+    /**
+     * @brief Returns the global coordinates of each local cell. `cell_coordinates()(l, d)` is the
+     * coordinate of cell l in dimension d.
+     */
+    MeshView<global_index_t **> const &cell_coordinates() const { return cell_coordinates_; }
 };
 
 } // namespace mesh
@@ -0,0 +1,223 @@
+/**
+ * @file mesh-balance.cpp
+ *
+ * @brief Implements the space-filling curve load balancer
+ * @date 2019-09-20
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+// Self Includes
+#include <mesh-balance.hpp>
+
+// STL Includes
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+// Third Party Includes
+#include <mpi/mpi.hpp>
+
+using namespace eap;
+using namespace eap::mesh;
+
+namespace {
+/**
+ * @brief Bits per coordinate when quantizing cell centers, so that a key fits in 64 bits
+ */
+unsigned CurveBits(int numdim) { return std::min(32u, 63u / static_cast<unsigned>(numdim)); }
+
+/**
+ * @brief Returns the exclusive prefix sum of `lengths` as Move segment starts
+ */
+std::vector<FortranLocalIndex> SegmentStarts(std::vector<local_index_t> const &lengths) {
+    std::vector<FortranLocalIndex> starts(lengths.size());
+
+    local_index_t start = 0;
+    for (size_t i = 0; i < lengths.size(); i++) {
+        starts[i] = start;
+        start += lengths[i];
+    }
+
+    return starts;
+}
+} // namespace
+
+CurveBalance eap::mesh::BalanceAlongCurve(Cells const &cells,
+                                          int const numdim,
+                                          Kokkos::View<double const *,
+                                                       Kokkos::LayoutStride,
+                                                       eap::HostMemorySpace> weights,
+                                          BlockLayoutMethod const method) {
+    using ExecutionSpace = Kokkos::DefaultHostExecutionSpace;
+
+    if (numdim < 1 || numdim > 3) {
+        throw std::invalid_argument("BalanceAlongCurve: numdim must be in [1, 3], got " +
+                                    std::to_string(numdim));
+    }
+
+    if (method != BlockLayoutMethod::Hilbert && method != BlockLayoutMethod::Morton) {
+        throw std::invalid_argument(
+            "BalanceAlongCurve: method must be BlockLayoutMethod::Hilbert or "
+            "BlockLayoutMethod::Morton");
+    }
+
+    local_index_t const num_local_cells = cells.num_local_cells();
+
+    auto comm = mpi::Comm::world();
+    auto const num_ranks = static_cast<size_t>(comm.size());
+
+    // Check the weights on every rank before the first collective, so that all ranks throw together
+    // instead of the others waiting on this one
+    std::string weights_error;
+    if (weights.extent(0) < num_local_cells) {
+        weights_error = "BalanceAlongCurve: weights must have an entry for each of the " +
+                        std::to_string(num_local_cells) + " local cells";
+    } else {
+        for (local_index_t l = 0; l < num_local_cells; l++) {
+            if (!(weights(l) >= 0.0)) {
+                weights_error = "BalanceAlongCurve: weights must be non-negative";
+                break;
+            }
+        }
+    }
+
+    if (comm.all_reduce(mpi::max(), static_cast<int>(!weights_error.empty()))) {
+        throw std::invalid_argument(weights_error.empty()
+                                        ? "BalanceAlongCurve: invalid weights on another rank"
+                                        : weights_error);
+    }
+
+    auto const cell_center = cells.cell_center();
+
+    // Quantize the cell centers over the global bounding box
+    auto const bits = CurveBits(numdim);
+    auto const max_coordinate = (global_index_t(1) << bits) - 1;
+
+    std::array<double, 3> lo{0.0, 0.0, 0.0};
+    std::array<double, 3> scale{0.0, 0.0, 0.0};
+    for (int d = 0; d < numdim; d++) {
+        Kokkos::MinMaxScalar<double> bounds;
+        Kokkos::parallel_reduce(
+            "eap::mesh::BalanceAlongCurve::bounds",
+            Kokkos::RangePolicy<ExecutionSpace>(0, num_local_cells),
+            [=](local_index_t const l, Kokkos::MinMaxScalar<double> &update) {
+                auto const x = cell_center(l, d);
+                if (x < update.min_val) update.min_val = x;
+                if (x > update.max_val) update.max_val = x;
+            },
+            Kokkos::MinMax<double>(bounds));
+
+        lo[d] = -comm.all_reduce(mpi::max(), -bounds.min_val);
+        auto const hi = comm.all_reduce(mpi::max(), bounds.max_val);
+
+        if (hi > lo[d]) {
+            scale[d] = static_cast<double>(max_coordinate) / (hi - lo[d]);
+        }
+    }
+
+    // Order the local cells along the curve
+    std::vector<std::pair<global_index_t, local_index_t>> keyed(num_local_cells);
+    auto *const keyed_data = keyed.data();
+
+    Kokkos::parallel_for("eap::mesh::BalanceAlongCurve::keys",
+                         Kokkos::RangePolicy<ExecutionSpace>(0, num_local_cells),
+                         [=](local_index_t const l) {
+                             internal::CurvePoint point{0, 0, 0};
+                             for (int d = 0; d < numdim; d++) {
+                                 auto const x = (cell_center(l, d) - lo[d]) * scale[d];
+                                 point[d] = std::min(max_coordinate,
+                                                     static_cast<global_index_t>(std::max(x, 0.0)));
+                             }
+
+                             keyed_data[l] = std::make_pair(
+                                 internal::CurveIndex(method, point, bits, numdim), l);
+                         });
+
+    std::sort(keyed.begin(), keyed.end());
+
+    CurveBalance balance;
+    balance.renumber_new_to_old = MeshView<FortranLocalIndex *>(
+        Kokkos::ViewAllocateWithoutInitializing("CurveBalance::renumber_new_to_old"),
+        num_local_cells);
+
+    std::vector<std::uint64_t> keys(num_local_cells);
+    for (local_index_t i = 0; i < num_local_cells; i++) {
+        balance.renumber_new_to_old(i) = keyed[i].second;
+        keys[i] = static_cast<std::uint64_t>(keyed[i].first);
+    }
+
+    // Running sum of the local weights along the curve. Without any weight, balance the number of
+    // cells instead.
+    std::vector<double> running_weight(num_local_cells + 1, 0.0);
+    for (local_index_t i = 0; i < num_local_cells; i++) {
+        running_weight[i + 1] = running_weight[i] + weights(keyed[i].second);
+    }
+
+    auto total_weight = comm.all_reduce(mpi::sum(), running_weight.back());
+    if (!(total_weight > 0.0)) {
+        std::iota(running_weight.begin(), running_weight.end(), 0.0);
+        total_weight = comm.all_reduce(mpi::sum(), running_weight.back());
+    }
+
+    // Returns twice this rank's running weight at the middle of the cells with key `key`
+    auto const local_middle_weight = [&](std::uint64_t const key) {
+        auto const below = std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+        auto const through = std::upper_bound(keys.begin(), keys.end(), key) - keys.begin();
+        return running_weight[below] + running_weight[through];
+    };
+
+    // A cell goes to the rank whose share of the global running weight holds the middle of its
+    // weight. Every rank bisects the curve for the key where rank r's share begins, which is the
+    // first key whose middle weight, summed over all ranks, reaches r / num_ranks of the total.
+    // The bisection takes the same number of steps everywhere, so the reductions always match up.
+    auto const key_bits = bits * static_cast<unsigned>(numdim);
+    std::uint64_t const key_end = std::uint64_t(1) << key_bits;
+
+    std::vector<std::uint64_t> first_key(num_ranks + 1, 0);
+    std::vector<std::uint64_t> upper_key(num_ranks + 1, key_end);
+    std::vector<double> middle_weight(num_ranks - 1);
+
+    for (unsigned step = 0; step <= key_bits; step++) {
+        for (size_t r = 1; r < num_ranks; r++) {
+            auto const key = first_key[r] + (upper_key[r] - first_key[r]) / 2;
+            middle_weight[r - 1] = local_middle_weight(key);
+        }
+
+        auto const global_middle_weight = comm.all_reduce(mpi::sum(), middle_weight);
+
+        for (size_t r = 1; r < num_ranks; r++) {
+            if (first_key[r] == upper_key[r]) continue;
+
+            auto const key = first_key[r] + (upper_key[r] - first_key[r]) / 2;
+            if (global_middle_weight[r - 1] >= 2.0 * total_weight * r / num_ranks) {
+                upper_key[r] = key;
+            } else {
+                first_key[r] = key + 1;
+            }
+        }
+    }
+
+    first_key[num_ranks] = key_end;
+
+    // The local cells are sorted along the curve, so each rank's key range is one segment
+    balance.send_length.assign(num_ranks, 0);
+    for (size_t r = 0; r < num_ranks; r++) {
+        auto const begin = std::lower_bound(keys.begin(), keys.end(), first_key[r]);
+        auto const end = std::lower_bound(begin, keys.end(), first_key[r + 1]);
+        balance.send_length[r] = static_cast<local_index_t>(end - begin);
+    }
+
+    balance.recv_length = comm.all_to_all(balance.send_length);
+
+    balance.send_start = SegmentStarts(balance.send_length);
+    balance.recv_start = SegmentStarts(balance.recv_length);
+    balance.new_num_local_cells =
+        std::accumulate(balance.recv_length.begin(), balance.recv_length.end(), local_index_t(0));
+
+    return balance;
+}
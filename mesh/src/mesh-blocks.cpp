@@ -10,16 +10,53 @@
 // Matching header
 #include <mesh-blocks.hpp>
 
-// Local includes
-#include "mesh-internal-log.hpp"
+// STL includes
+#include <algorithm>
+#include <array>
 
 using namespace eap::mesh;
 
+namespace {
+using eap::global_index_t;
+
+/**
+ * @brief Returns the number of bits needed to hold coordinates in [0, extent)
+ */
+unsigned BitsFor(global_index_t extent) {
+    unsigned bits = 0;
+    while ((global_index_t(1) << bits) < extent) {
+        bits++;
+    }
+    return bits;
+}
+} // namespace
+
+internal::BlockCurve::BlockCurve(BlockLayoutMethod const method,
+                                 std::array<global_index_t, 3> const &extents)
+    : method_(method), extents_{extents[0], extents[1], extents[2]} {
+    // Only curve the dimensions that have more than one block
+    global_index_t max_extent = 1;
+    for (unsigned d = 0; d < 3; d++) {
+        if (extents[d] > 1) {
+            dims_[num_dims_++] = d;
+            max_extent = std::max(max_extent, extents[d]);
+        }
+    }
+
+    bits_ = BitsFor(max_extent);
+    if (bits_ * num_dims_ > 64) {
+        std::stringstream ss;
+        ss << "Block extents (" << extents[0] << "," << extents[1] << "," << extents[2]
+           << ") are too large to lay out along a space-filling curve.";
+        throw std::range_error(ss.str());
+    }
+}
+
 BlockLayout::BlockLayout(BlockLayoutMethod const method,
                          global_index_t const extent0,
                          global_index_t const extent1,
                          global_index_t const extent2)
-    : method(method), extents_{extent0, extent1, extent2} {
+    : method_(method), extents_{extent0, extent1, extent2} {
     auto const it = std::find_if(
         extents_.cbegin(), extents_.cend(), [](auto const extent) { return extent <= 0; });
 
@@ -27,11 +64,7 @@ BlockLayout::BlockLayout(BlockLayoutMethod const method,
         throw InvalidBlockExtentsError(*it);
     }
 
-    if (method == BlockLayoutMethod::Hilbert) {
-        this->method = BlockLayoutMethod::ColumnMajor;
-        internal::mesh_err()
-            << "BlockLayoutMethod::Hilbert (block_method = 2) is no longer supported. "
-               "Falling back to BlockLayoutMethod::ColumnMajor (block_method = 1)"
-            << std::endl;
+    if (method == BlockLayoutMethod::Hilbert || method == BlockLayoutMethod::Morton) {
+        curve_ = internal::BlockCurve(method, extents_);
     }
 }
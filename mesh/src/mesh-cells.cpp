@@ -51,7 +51,7 @@ Cells::Cells(eap::comm::TokenBuilder const &token_builder)
 }
 
 void Cells::SetNumLocalCells(local_index_t num_local_cells) {
-    EE_DIAG_PRE
+    EE_DIAG_PRE_DEBUG_IN(EAP_MESH_CHECK_LEVEL)
 
     switch (global_state_consistent_) {
     case GlobalStateConsistency::Consistent:
@@ -71,7 +71,7 @@ void Cells::SetNumLocalCells(local_index_t num_local_cells) {
     }
     num_local_cells_ = num_local_cells;
 
-    EE_DIAG_POST_MSG(EE_DBG(num_local_cells))
+    EE_DIAG_POST_MSG_DEBUG_IN(EAP_MESH_CHECK_LEVEL, EE_DBG(num_local_cells))
 }
 
 void Cells::UpdateGlobalBase() {
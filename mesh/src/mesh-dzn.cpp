@@ -11,6 +11,13 @@
 #include <mesh-dzn.hpp>
 #include <mesh-dzn_compute.hpp>
 
+// STL Includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 // Third Party Includes
 #include <Kokkos_ScatterView.hpp>
 
@@ -21,6 +28,17 @@ using eap::mesh::DefinedZoneResolutionInfo;
 
 using namespace eap;
 
+namespace {
+/// Number of points per bin the ZoneGrid aims for
+constexpr local_index_t ZONE_GRID_POINTS_PER_BIN = 64;
+
+/// Most bins a ZoneGrid will allocate
+constexpr local_index_t ZONE_GRID_MAX_BINS = 1 << 15;
+
+/// Bounding boxes are widened by this fraction of their size to be safe against round-off
+constexpr double ZONE_BOUNDS_TOLERANCE = 1e-9;
+} // namespace
+
 eap::mesh::ZoneOptionsDigits::ZoneOptionsDigits(int digits) : digits_(digits) {
     EE_DIAG_PRE
 
@@ -179,6 +197,47 @@ nonstd::optional<local_index_t> eap::mesh::SplitDZNFilterKode(DefinedZoneResolut
         });
 }
 
+void eap::mesh::FindDZNs(
+    DefinedZoneResolutionInfo const &dzn,
+    std::uint8_t numdim,
+    double time,
+    DZNPoints points,
+    Kokkos::View<utility::OptionalInteger<local_index_t> *, eap::HostMemorySpace> found) {
+    FindDZNsWithFilter(
+        dzn, numdim, time, points, found, [](local_index_t, ZoneOptions const &) { return true; });
+}
+
+void eap::mesh::SplitDZNs(DefinedZoneResolutionInfo const &dzn,
+                          std::uint8_t numdim,
+                          double time,
+                          DZNPoints points,
+                          Kokkos::View<local_index_t const *, eap::HostMemorySpace> level_base,
+                          Kokkos::View<local_index_t *, eap::HostMemorySpace> level_set) {
+    SplitDZNsWithFilter(
+        dzn, numdim, time, points, level_base, level_set, [](local_index_t, ZoneOptions const &) {
+            return true;
+        });
+}
+
+void eap::mesh::SplitDZNsFilterKode(
+    DefinedZoneResolutionInfo const &dzn,
+    std::uint8_t numdim,
+    double time,
+    Kode kode,
+    DZNPoints points,
+    Kokkos::View<local_index_t const *, eap::HostMemorySpace> level_base,
+    Kokkos::View<local_index_t *, eap::HostMemorySpace> level_set) {
+    SplitDZNsWithFilter(dzn,
+                        numdim,
+                        time,
+                        points,
+                        level_base,
+                        level_set,
+                        [kode](local_index_t, ZoneOptions options) {
+                            return options.kode == kode || options.kode == Kode::Unconditional;
+                        });
+}
+
 void eap::mesh::ProcessCellsInDZNFilterKode(
     DefinedZoneResolutionInfo const &dzn,
     std::uint8_t numdim,
@@ -253,230 +312,298 @@ void eap::mesh::ProcessCellsInDZNFilterWithMaterial(
                                 });
 }
 
-void eap::mesh::internal::ProcessCellsInDZN(
-    DefinedZoneResolutionInfo const &dzn,
-    size_t n,
-    std::uint8_t numdim,
-    Cells const &cells,
-    double time,
-    local_index_t llow,
-    local_index_t lhigh,
-    Kokkos::View<local_index_t const *, eap::HostMemorySpace> level_base,
-    Kokkos::View<local_index_t *> lbuf,
-    Kokkos::View<local_index_t *, eap::HostMemorySpace> level_set) {
-    using namespace internal;
-
+eap::mesh::internal::CompiledDZN eap::mesh::internal::CompileDZN(
+    DefinedZoneResolutionInfo const &dzn, std::uint8_t numdim, double time, local_index_t n) {
     using eap::utility::Square;
-    using eap::utility::SquarePair;
 
-    EE_DIAG_PRE
+    CompiledDZN zone;
+    zone.options = dzn.options(n).GetOptions();
+    zone.level = dzn.levels(n);
 
-    auto const options = dzn.options(n).GetOptions();
+    auto &geometry = zone.geometry;
+    for (auto &field : geometry) {
+        field = 0.0;
+    }
 
-    auto const levels = dzn.levels;
-    auto const use_inside = !options.outer;
+    auto const rrange = ApplyDeltas(dzn.radiuses(n), dzn.radius_deltas(n), time);
+    Kokkos::pair<double, double> const ranges[3] = {ApplyDeltas(dzn.xs(n), dzn.x_deltas(n), time),
+                                                    ApplyDeltas(dzn.ys(n), dzn.y_deltas(n), time),
+                                                    ApplyDeltas(dzn.zs(n), dzn.z_deltas(n), time)};
+
+    // Dimensions past numdim stay zero so they drop out of the shape tests
+    double axis_squared = 0.0;
+    for (int d = 0; d < numdim; d++) {
+        geometry[START_X + d] = ranges[d].first;
+        geometry[END_X + d] = ranges[d].second;
+        geometry[AXIS_X + d] = ranges[d].second - ranges[d].first;
+        axis_squared += Square(geometry[AXIS_X + d]);
+    }
 
-    auto const cell_center = cells.cell_center();
+    geometry[R_START] = rrange.first;
+    geometry[R_DELTA] = rrange.second - rrange.first;
+    geometry[INV_AXIS_SQUARED] = axis_squared > 0.0 ? 1.0 / axis_squared : 0.0;
 
-    auto const for_cells = [llow, lhigh](auto fn) {
-        Kokkos::parallel_for(Kokkos::RangePolicy<>(llow, lhigh), fn);
-    };
+    zone.valid = true;
+    switch (zone.options.use) {
+    case ZoneShape::BricksAndRectangles:
+        break;
+    case ZoneShape::SpheresAndCircles:
+        // A shell if the radius range is non-empty, otherwise a ball of the first radius
+        if (rrange.second > rrange.first) {
+            geometry[R_LOWER_SQUARED] = Square(rrange.first);
+            geometry[R_UPPER_SQUARED] = Square(rrange.second);
+        } else {
+            geometry[R_LOWER_SQUARED] = -1.0;
+            geometry[R_UPPER_SQUARED] = Square(rrange.first);
+        }
+        break;
+    case ZoneShape::ConesAndWedges:
+        zone.valid = rrange.first >= 0.0 && rrange.second >= 0.0 && axis_squared > 0.0;
+        break;
+    case ZoneShape::Cylinder:
+        zone.valid = rrange.first >= 0.0 && rrange.second > rrange.first && axis_squared > 0.0;
+        geometry[R_LOWER_SQUARED] = Square(rrange.first);
+        geometry[R_UPPER_SQUARED] = Square(rrange.second);
+        break;
+    }
+
+    return zone;
+}
 
-    auto const set_buf = KOKKOS_LAMBDA(local_index_t l, bool inside) {
-        if (inside == use_inside) {
-            lbuf(l - llow) = levels(n);
+eap::mesh::internal::CompiledDZNArrays<eap::HostMemorySpace>
+eap::mesh::internal::CompileDZNs(DefinedZoneResolutionInfo const &dzn,
+                                 std::uint8_t numdim,
+                                 double time,
+                                 std::vector<local_index_t> const &selected) {
+    local_index_t const num_zones = selected.size();
+
+    CompiledDZNArrays<eap::HostMemorySpace> zones;
+    zones.index = decltype(zones.index)("eap::mesh::CompiledDZNs::index", num_zones);
+    zones.options = decltype(zones.options)("eap::mesh::CompiledDZNs::options", num_zones);
+    zones.level = decltype(zones.level)("eap::mesh::CompiledDZNs::level", num_zones);
+    zones.valid = decltype(zones.valid)("eap::mesh::CompiledDZNs::valid", num_zones);
+    zones.geometry =
+        decltype(zones.geometry)("eap::mesh::CompiledDZNs::geometry", num_zones, NUM_DZN_FIELDS);
+
+    for (local_index_t k = 0; k < num_zones; k++) {
+        auto const n = selected[k];
+        auto const zone = CompileDZN(dzn, numdim, time, n);
+
+        zones.index(k) = n;
+        zones.options(k) = zone.options;
+        zones.level(k) = zone.level;
+        zones.valid(k) = zone.valid;
+        for (int f = 0; f < NUM_DZN_FIELDS; f++) {
+            zones.geometry(k, f) = zone.geometry[f];
         }
-    };
+    }
 
-    auto const rrange = ApplyDeltas(dzn.radiuses(n), dzn.radius_deltas(n), time);
-    auto const xrange = ApplyDeltas(dzn.xs(n), dzn.x_deltas(n), time);
-    auto const yrange = ApplyDeltas(dzn.ys(n), dzn.y_deltas(n), time);
-    auto const zrange = ApplyDeltas(dzn.ys(n), dzn.y_deltas(n), time);
-
-    auto const drtest = rrange.second - rrange.first;
-    auto const dxtest = xrange.second - xrange.first;
-    auto const dytest = yrange.second - yrange.first;
-    auto const dztest = zrange.second - zrange.first;
-
-    if (options.use == ZoneShape::BricksAndRectangles) {
-        if (numdim == 3) {
-            for_cells(KOKKOS_LAMBDA(local_index_t l) {
-                set_buf(l,
-                        InRange(xrange, cell_center(l, X_DIR)) &&
-                            InRange(yrange, cell_center(l, Y_DIR)) &&
-                            InRange(zrange, cell_center(l, Z_DIR)));
-            });
-        } else if (numdim == 2) {
-            for_cells(KOKKOS_LAMBDA(local_index_t l) {
-                set_buf(l,
-                        InRange(xrange, cell_center(l, X_DIR)) &&
-                            InRange(yrange, cell_center(l, Y_DIR)));
-            });
+    return zones;
+}
+
+void eap::mesh::internal::GetZoneBounds(CompiledDZNArrays<eap::HostMemorySpace> const &zones,
+                                        std::uint8_t numdim,
+                                        local_index_t k,
+                                        Kokkos::Array<double, 3> &lo,
+                                        Kokkos::Array<double, 3> &hi) {
+    auto const &geometry = zones.geometry;
+    auto const &options = zones.options(k);
+
+    auto const infinity = std::numeric_limits<double>::infinity();
+
+    for (int d = 0; d < 3; d++) {
+        lo[d] = -infinity;
+        hi[d] = infinity;
+    }
+
+    // Outer DZNs can match anywhere
+    if (options.outer) return;
+
+    // Spheres are centered at the start point; cones and cylinders run along the segment from
+    // the start point to the end point.
+    double radius = 0.0;
+    bool segment = false;
+    switch (options.use) {
+    case ZoneShape::BricksAndRectangles:
+        break;
+    case ZoneShape::SpheresAndCircles:
+        radius = std::sqrt(geometry(k, R_UPPER_SQUARED));
+        break;
+    case ZoneShape::ConesAndWedges:
+        radius = std::max(geometry(k, R_START), geometry(k, R_START) + geometry(k, R_DELTA));
+        segment = true;
+        break;
+    case ZoneShape::Cylinder:
+        radius = std::sqrt(geometry(k, R_UPPER_SQUARED));
+        segment = true;
+        break;
+    }
+
+    for (int d = 0; d < numdim; d++) {
+        auto const start = geometry(k, START_X + d);
+        auto const end = geometry(k, END_X + d);
+
+        if (options.use == ZoneShape::BricksAndRectangles) {
+            lo[d] = start;
+            hi[d] = end;
         } else {
-            for_cells(KOKKOS_LAMBDA(local_index_t l) {
-                set_buf(l, InRange(xrange, cell_center(l, X_DIR)));
-            });
+            lo[d] = (segment ? std::min(start, end) : start) - radius;
+            hi[d] = (segment ? std::max(start, end) : start) + radius;
         }
-    } else if (options.use == ZoneShape::SpheresAndCircles) {
-        if (rrange.second > rrange.first) {
-            if (numdim == 3) {
-                for_cells(KOKKOS_LAMBDA(local_index_t l) {
-                    set_buf(l,
-                            InRange(SquarePair(rrange),
-                                    Square(cell_center(l, X_DIR) - xrange.first) +
-                                        Square(cell_center(l, Y_DIR) - yrange.first) +
-                                        Square(cell_center(l, Z_DIR) - zrange.first)));
-                });
-            } else if (numdim == 2) {
-                for_cells(KOKKOS_LAMBDA(local_index_t l) {
-                    set_buf(l,
-                            InRange(SquarePair(rrange),
-                                    Square(cell_center(l, X_DIR) - xrange.first) +
-                                        Square(cell_center(l, Y_DIR) - yrange.first)));
-                });
-            } else {
-                for_cells(KOKKOS_LAMBDA(local_index_t l) {
-                    set_buf(
-                        l,
-                        InRange(SquarePair(rrange), Square(cell_center(l, X_DIR) - xrange.first)));
-                });
-            }
-        } else if (rrange.first > 0.0) {
-            if (numdim == 3) {
-                for_cells(KOKKOS_LAMBDA(local_index_t l) {
-                    set_buf(l,
-                            Square(cell_center(l, X_DIR) - xrange.first) +
-                                    Square(cell_center(l, Y_DIR) - yrange.first) +
-                                    Square(cell_center(l, Z_DIR) - zrange.first) <=
-                                Square(rrange.first));
-                });
-            } else if (numdim == 2) {
-                for_cells(KOKKOS_LAMBDA(local_index_t l) {
-                    set_buf(l,
-                            Square(cell_center(l, X_DIR) - xrange.first) +
-                                    Square(cell_center(l, Y_DIR) - yrange.first) <=
-                                Square(rrange.first));
-                });
-            } else {
-                for_cells(KOKKOS_LAMBDA(local_index_t l) {
-                    set_buf(l,
-                            Square(cell_center(l, X_DIR) - xrange.first) <= Square(rrange.first));
-                });
-            }
+
+        auto const pad =
+            ZONE_BOUNDS_TOLERANCE * std::max({1.0, std::abs(lo[d]), std::abs(hi[d])});
+        lo[d] -= pad;
+        hi[d] += pad;
+    }
+}
+
+void eap::mesh::internal::CheckZoneShape(ZoneShape use, std::uint8_t numdim) {
+    EE_DIAG_PRE
+
+    if (numdim >= 2) return;
+
+    if (use == ZoneShape::ConesAndWedges) {
+        EE_RAISE("typdzn 1st digit of 2 selected a ZoneShape::ConesAndWedges DZN for a "
+                 << numdim
+                 << "dimension problem. ConesAndWedges DZNs are only supported for 2D and "
+                    "3D problems.");
+    } else if (use == ZoneShape::Cylinder) {
+        EE_RAISE("typdzn 1st digit of 3 selected a ZoneShape::Cylinder DZN for a "
+                 << numdim
+                 << "dimension problem. Cylinder DZNs are only supported for 2D and "
+                    "3D problems.");
+    }
+
+    EE_DIAG_POST
+}
+
+eap::mesh::internal::ZoneGrid<eap::HostMemorySpace>
+eap::mesh::internal::BinZones(CompiledDZNArrays<eap::HostMemorySpace> const &zones,
+                              std::uint8_t numdim,
+                              Kokkos::Array<double, 3> const &lo,
+                              Kokkos::Array<double, 3> const &extent,
+                              local_index_t num_points) {
+    EE_DIAG_PRE
+
+    local_index_t const num_zones = zones.index.extent(0);
+
+    ZoneGrid<eap::HostMemorySpace> grid;
+    for (int d = 0; d < 3; d++) {
+        grid.lo[d] = lo[d];
+        grid.inv_width[d] = 0.0;
+        grid.num_bins[d] = 1;
+    }
+
+    // Split the point bounds into roughly cubic bins
+    auto const target_bins = std::max<local_index_t>(
+        1, std::min(num_points / ZONE_GRID_POINTS_PER_BIN, ZONE_GRID_MAX_BINS));
+
+    double volume = 1.0;
+    int num_extended = 0;
+    for (int d = 0; d < numdim; d++) {
+        if (extent[d] > 0.0) {
+            volume *= extent[d];
+            num_extended++;
         }
+    }
 
-    } else if (options.use == ZoneShape::ConesAndWedges) {
-        if (numdim == 3) {
-            auto const denom = Square(dxtest) + Square(dytest) + Square(dztest);
-
-            if (rrange.first >= 0.0 && rrange.second >= 0.0 && denom > 0.0) {
-                auto const factor = 1.0 / denom;
-                for_cells(KOKKOS_LAMBDA(local_index_t l) {
-                    auto const s = (dxtest * (cell_center(l, X_DIR) - xrange.first) +
-                                    dytest * (cell_center(l, Y_DIR) - yrange.first) +
-                                    dztest * (cell_center(l, Z_DIR) - zrange.first)) *
-                                   factor;
-                    auto const rctest = rrange.first + s * drtest;
-                    auto const xctest = xrange.first + s * dxtest;
-                    auto const yctest = yrange.first + s * dytest;
-                    auto const zctest = zrange.first + s * dztest;
-
-                    auto const rtest = Square(rctest);
-
-                    auto const rsqr = Square(xctest - cell_center(l, X_DIR)) +
-                                      Square(yctest - cell_center(l, Y_DIR)) +
-                                      Square(zctest - cell_center(l, Z_DIR));
-                    set_buf(l, s >= 0.0 && s <= 1.0 && rsqr <= rtest);
-                });
+    if (num_extended > 0 && target_bins > 1) {
+        auto const width = std::pow(volume / target_bins, 1.0 / num_extended);
+
+        for (int d = 0; d < numdim; d++) {
+            if (extent[d] > 0.0) {
+                grid.num_bins[d] = static_cast<local_index_t>(
+                    std::min<double>(std::ceil(extent[d] / width), target_bins));
             }
-        } else if (numdim == 2) {
-            auto const denom = Square(dxtest) + Square(dytest);
-
-            if (rrange.first >= 0.0 && rrange.second >= 0.0 && denom > 0.0) {
-                auto const factor = 1.0 / denom;
-                for_cells(KOKKOS_LAMBDA(local_index_t l) {
-                    auto const s = (dxtest * (cell_center(l, X_DIR) - xrange.first) +
-                                    dytest * (cell_center(l, Y_DIR) - yrange.first)) *
-                                   factor;
-                    auto const rctest = rrange.first + s * drtest;
-                    auto const xctest = xrange.first + s * dxtest;
-                    auto const yctest = yrange.first + s * dytest;
-
-                    auto const rtest = Square(rctest);
-
-                    auto const rsqr = Square(xctest - cell_center(l, X_DIR)) +
-                                      Square(yctest - cell_center(l, Y_DIR));
-                    set_buf(l, s >= 0.0 && s <= 1.0 && rsqr <= rtest);
-                });
+        }
+
+        // A thin dimension keeps its single bin while the others each reach target_bins, so cap
+        // the total by halving the most-split dimension
+        auto const total_bins = [&grid]() {
+            return std::int64_t(grid.num_bins[0]) * grid.num_bins[1] * grid.num_bins[2];
+        };
+        while (total_bins() > target_bins) {
+            auto &widest = *std::max_element(grid.num_bins.data(), grid.num_bins.data() + 3);
+            widest = (widest + 1) / 2;
+        }
+
+        for (int d = 0; d < numdim; d++) {
+            if (extent[d] > 0.0) {
+                grid.inv_width[d] = grid.num_bins[d] / extent[d];
             }
-        } else {
-            EE_RAISE("typdzn 1st digit of 2 selected a ZoneShape::ConesAndWedges DZN for a "
-                     << numdim
-                     << "dimension problem. ConesAndWedges DZNs are only supported for 2D and "
-                        "3D problems.");
         }
-    } else if (options.use == ZoneShape::Cylinder) {
-        if (numdim == 3) {
-            auto const denom = Square(dxtest) + Square(dytest) + Square(dztest);
-
-            if (rrange.first >= 0.0 && rrange.second > rrange.first && denom > 0.0) {
-                auto const factor = 1.0 / denom;
-                for_cells(KOKKOS_LAMBDA(local_index_t l) {
-                    auto const s = (dxtest * (cell_center(l, X_DIR) - xrange.first) +
-                                    dytest * (cell_center(l, Y_DIR) - yrange.first) +
-                                    dztest * (cell_center(l, Z_DIR) - zrange.first)) *
-                                   factor;
-                    auto const xctest = xrange.first + s * dxtest;
-                    auto const yctest = yrange.first + s * dytest;
-                    auto const zctest = zrange.first + s * dztest;
-
-                    auto const rsqr = Square(xctest - cell_center(l, X_DIR)) +
-                                      Square(yctest - cell_center(l, Y_DIR)) +
-                                      Square(zctest - cell_center(l, Z_DIR));
-
-                    set_buf(l,
-                            InRange(Kokkos::make_pair(0.0, 1.0), s) &&
-                                InRange(SquarePair(rrange), rsqr));
-                });
+    }
+
+    local_index_t const num_bins = grid.num_bins[0] * grid.num_bins[1] * grid.num_bins[2];
+
+    // Find the range of bins each DZN overlaps. DZNs that can't reach any point are dropped.
+    struct BinRange {
+        bool overlaps;
+        Kokkos::Array<local_index_t, 3> lo;
+        Kokkos::Array<local_index_t, 3> hi;
+    };
+
+    std::vector<BinRange> ranges(num_zones);
+    for (local_index_t k = 0; k < num_zones; k++) {
+        Kokkos::Array<double, 3> zone_lo;
+        Kokkos::Array<double, 3> zone_hi;
+        GetZoneBounds(zones, numdim, k, zone_lo, zone_hi);
+
+        auto &range = ranges[k];
+
+        range.overlaps = true;
+        for (int d = 0; d < 3; d++) {
+            range.lo[d] = 0;
+            range.hi[d] = grid.num_bins[d] - 1;
+
+            if (d >= numdim) continue;
+
+            if (zone_hi[d] < grid.lo[d] || zone_lo[d] > grid.lo[d] + extent[d]) {
+                range.overlaps = false;
+            } else {
+                range.lo[d] = grid.BinOf(d, zone_lo[d]);
+                range.hi[d] = grid.BinOf(d, zone_hi[d]);
             }
-        } else if (numdim == 2) {
-            auto const denom = Square(dxtest) + Square(dytest);
-
-            if (rrange.first >= 0.0 && rrange.second > rrange.first && denom > 0.0) {
-                auto const factor = 1.0 / denom;
-                for_cells(KOKKOS_LAMBDA(local_index_t l) {
-                    auto const s = (dxtest * (cell_center(l, X_DIR) - xrange.first) +
-                                    dytest * (cell_center(l, Y_DIR) - yrange.first)) *
-                                   factor;
-                    auto const xctest = xrange.first + s * dxtest;
-                    auto const yctest = yrange.first + s * dytest;
-
-                    auto const rsqr = Square(xctest - cell_center(l, X_DIR)) +
-                                      Square(yctest - cell_center(l, Y_DIR));
-
-                    set_buf(l,
-                            InRange(Kokkos::make_pair(0.0, 1.0), s) &&
-                                InRange(SquarePair(rrange), rsqr));
-                });
+        }
+    }
+
+    // List the DZNs of each bin in compressed rows, keeping them in priority order
+    grid.bin_offset = Kokkos::View<local_index_t *, eap::HostMemorySpace>(
+        "eap::mesh::internal::BinZones::bin_offset", num_bins + 1);
+    auto const bin_offset = grid.bin_offset;
+
+    auto const for_bins = [&grid](BinRange const &range, auto fn) {
+        for (auto k = range.lo[2]; k <= range.hi[2]; k++) {
+            for (auto j = range.lo[1]; j <= range.hi[1]; j++) {
+                for (auto i = range.lo[0]; i <= range.hi[0]; i++) {
+                    fn(i + grid.num_bins[0] * (j + grid.num_bins[1] * k));
+                }
             }
-        } else {
-            EE_RAISE("typdzn 1st digit of 3 selected a ZoneShape::Cylinder DZN for a "
-                     << numdim
-                     << "dimension problem. Cylinder DZNs are only supported for 2D and "
-                        "3D problems.");
         }
+    };
+
+    for (auto const &range : ranges) {
+        if (!range.overlaps) continue;
+        for_bins(range, [&](local_index_t const bin) { bin_offset(bin + 1)++; });
     }
 
-    if (options.add) {
-        for_cells(KOKKOS_LAMBDA(local_index_t l) {
-            if (lbuf(l - llow) != 0)
-                level_set(l) = std::max<local_index_t>(1, level_base(l) + lbuf(l - llow));
-        });
-    } else {
-        for_cells(KOKKOS_LAMBDA(local_index_t l) {
-            if (lbuf(l - llow) > 0) level_set(l) = lbuf(l - llow);
-        });
+    for (local_index_t bin = 0; bin < num_bins; bin++) {
+        bin_offset(bin + 1) += bin_offset(bin);
+    }
+
+    grid.bin_zones = Kokkos::View<local_index_t *, eap::HostMemorySpace>(
+        Kokkos::ViewAllocateWithoutInitializing("eap::mesh::internal::BinZones::bin_zones"),
+        bin_offset(num_bins));
+    auto const bin_zones = grid.bin_zones;
+
+    std::vector<local_index_t> bin_fill(bin_offset.data(), bin_offset.data() + num_bins);
+    for (local_index_t k = 0; k < ranges.size(); k++) {
+        if (!ranges[k].overlaps) continue;
+        for_bins(ranges[k], [&](local_index_t const bin) { bin_zones(bin_fill[bin]++) = k; });
     }
 
+    return grid;
+
     EE_DIAG_POST
-}
\ No newline at end of file
+}
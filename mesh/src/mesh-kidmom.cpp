@@ -11,12 +11,12 @@
 #include <mesh-kidmom.hpp>
 
 // STL Includes
+#include <algorithm>
 #include <limits>
 #include <numeric>
 #include <utility>
 
 // Third Party Includes
-#include <Kokkos_ScatterView.hpp>
 #include <mpi/mpi.hpp>
 
 // Internal Includes
@@ -32,6 +32,11 @@ using namespace eap::mesh;
 
 using eap::utility::nullint;
 
+namespace {
+/// Smallest block of cells worth handing to its own thread when building lpoint
+constexpr local_index_t BUILD_PACK_MIN_BLOCK = 4096;
+} // namespace
+
 // ---- KidMom Public Routines ----
 
 KidMom::KidMom()
@@ -40,7 +45,11 @@ KidMom::KidMom()
       ltop_("KidMom::ltop", 0),
       all_top_("KidMom::all_top", 0),
       lpoint_("KidMom::lpoint", 0),
-      lopack_("KidMom::lopack", 0) {}
+      lopack_("KidMom::lopack", 0),
+      loseg_("KidMom::loseg", 0),
+      lseg_("KidMom::lseg", 0),
+      renumber_new_to_old_("KidMom::renumber_new_to_old", 0),
+      renumber_old_to_new_("KidMom::renumber_old_to_new", 0) {}
 
 void KidMom::ResizeLocal(local_index_t num_cells, local_index_t newsize) {
     EE_PRELUDE
@@ -60,17 +69,69 @@ void KidMom::InitializeLevel1() {
     Kokkos::deep_copy(cell_daughter_, nullint);
 }
 
-std::pair<local_index_t, global_index_t> KidMom::BuildTop(Cells const &cells) {
+local_index_t KidMom::BuildTop(Cells const &cells) {
+    EE_DIAG_PRE
+
+    // A previous BuildTop may not have been followed by SetupAllTop
+    WaitSumNumTop();
+
+    // Need to capture these by name since otherwise KOKKOS_LAMBDA will capture them by reference
+    // via `this`
+    auto const ltop = ltop_;
+    auto const cell_daughter = cell_daughter_;
+    auto const cell_active = cells.cell_active();
+
+    // Compacts the top cells into ltop in cell order. The predicate must match KidMom::IsTop.
     local_index_t num_top = 0;
-    for (local_index_t l = 0; l < cells.num_local_cells(); l++) {
-        if (IsTop(cells, l)) {
-            ltop_(num_top) = l;
-            num_top++;
-        }
+    Kokkos::parallel_scan(
+        "eap::mesh::KidMom::BuildTop::compact_ltop",
+        Kokkos::RangePolicy<Kokkos::DefaultHostExecutionSpace>(0, cells.num_local_cells()),
+        KOKKOS_LAMBDA(local_index_t const l, local_index_t &update, bool const is_final) {
+            if (cell_active(l) && !cell_daughter(l)) {
+                if (is_final) {
+                    ltop(update) = l;
+                }
+                update++;
+            }
+        },
+        num_top);
+
+    pending_top_sum_.reset(new PendingTopSum);
+    pending_top_sum_->local = num_top;
+
+    auto comm = mpi::Comm::world();
+    mpi::check_result(MPI_Iallreduce(&pending_top_sum_->local,
+                                     &pending_top_sum_->global,
+                                     1,
+                                     mpi::DatatypeTraits<global_index_t>::mpi_datatype(),
+                                     MPI_SUM,
+                                     comm.comm(),
+                                     &pending_top_sum_->request));
+
+    return num_top;
+
+    EE_DIAG_POST
+}
+
+void KidMom::PendingTopSumDeleter::operator()(PendingTopSum *const pending) const noexcept {
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+
+    if (!finalized && pending->request != MPI_REQUEST_NULL) {
+        MPI_Wait(&pending->request, MPI_STATUS_IGNORE);
+    }
+
+    delete pending;
+}
+
+global_index_t KidMom::WaitSumNumTop() {
+    if (pending_top_sum_) {
+        mpi::check_result(MPI_Wait(&pending_top_sum_->request, MPI_STATUS_IGNORE));
+        sum_num_top_ = pending_top_sum_->global;
+        pending_top_sum_.reset();
     }
 
-    return std::make_pair(num_top,
-                          mpi::Comm::world().all_reduce(mpi::sum(), (global_index_t)num_top));
+    return sum_num_top_;
 }
 
 local_index_t KidMom::SetupAllTop(Cells const &cells, local_index_t num_top) {
@@ -91,87 +152,105 @@ local_index_t KidMom::SetupAllTop(Cells const &cells, local_index_t num_top) {
 
 void KidMom::BuildPack(Cells const &cells,
                        MeshDualView<OptionalFortranLocalIndex *> cell_level_dual) {
+    using HostExecSpace = Kokkos::DefaultHostExecutionSpace;
+
     EE_DIAG_PRE
 
     EE_ASSERT(lpoint_.extent(0) >= cell_level_dual.extent(0));
     EE_ASSERT(!cell_level_dual.need_sync_device());
 
-    auto cell_level = cell_level_dual.view_device();
-
-    auto const max_levels = eap::utility::LocalGlobalMax(cell_level);
+    auto const max_levels = eap::utility::LocalGlobalMax(cell_level_dual.view_device());
     num_pack_ = max_levels.local.value();
     max_num_pack_ = max_levels.global.value();
     num_levels_ = num_pack_ + 1;
 
     lopack_.resize(num_levels_ + 1);
 
-    // Count the number of cells at each level
-    {
-        // Currently using Serial on Host, but speed up can be achieved using OpenMP at
-        // >~100k cells. Consider supporting later.
-        using ExecSpace =
-            std::conditional<std::is_same<Kokkos::DefaultHostExecutionSpace,
-                                          decltype(cell_level)::execution_space>::value,
-                             Kokkos::Serial,
-                             Kokkos::DefaultExecutionSpace>::type;
-
-        Kokkos::View<local_index_t *, ExecSpace> level_counts(
-            "eap::mesh::Kidmom::BuildPack::level_counts", num_levels_);
-        {
-            auto level_counts_scatter =
-                Kokkos::Experimental::create_scatter_view<Kokkos::Experimental::ScatterSum,
-                                                          void,
-                                                          void,
-                                                          local_index_t *,
-                                                          ExecSpace>(level_counts);
-
-            // Count the number of cells at each level
-            Kokkos::parallel_for(
-                "eap::mesh::KidMom::BuildPack::count_levels",
-                Kokkos::RangePolicy<ExecSpace>(0, cells.num_local_cells()),
-                KOKKOS_LAMBDA(int const i) {
-                    auto level_counts = level_counts_scatter.access();
-                    if (cell_level(i)) {
-                        level_counts(local_index_t(*cell_level(i))) += 1;
-                    }
-                });
-
-            Kokkos::Experimental::contribute(level_counts, level_counts_scatter);
-        }
-
-        lopack_.sync_device();
+    cell_level_dual.sync_host();
 
-        eap::utility::InclusiveExclusiveSumScan<decltype(level_counts)::const_type,
-                                                decltype(lopack_)::t_dev,
-                                                ExecSpace>(level_counts, lopack_.view_device());
+    auto const cell_level = cell_level_dual.view_host();
+    auto const num_cells = cells.num_local_cells();
+    auto const num_levels = num_levels_;
+
+    // lpoint_ is filled with a stable counting sort on cell_level. The cells are split into one
+    // contiguous block per host thread: each block is histogrammed and later scattered by a single
+    // thread, so cells within a level remain ordered by cell index without requiring atomics.
+    local_index_t const num_blocks = std::max(
+        local_index_t(1),
+        std::min(local_index_t(HostExecSpace::concurrency()),
+                 local_index_t((num_cells + BUILD_PACK_MIN_BLOCK - 1) / BUILD_PACK_MIN_BLOCK)));
+    local_index_t const block_size = (num_cells + num_blocks - 1) / num_blocks;
+
+    // block_offsets(b, level) starts as the count of cells at `level` in block `b`, and is then
+    // scanned into the position in lpoint_ where block `b` writes its first cell at `level`.
+    Kokkos::View<local_index_t **, Kokkos::LayoutRight, eap::HostMemorySpace> block_offsets(
+        "eap::mesh::KidMom::BuildPack::block_offsets", num_blocks, num_levels);
+
+    // Count the number of cells at each level in each block
+    Kokkos::parallel_for(
+        "eap::mesh::KidMom::BuildPack::count_levels",
+        Kokkos::RangePolicy<HostExecSpace>(0, num_blocks),
+        KOKKOS_LAMBDA(local_index_t const b) {
+            local_index_t const lo = b * block_size;
+            local_index_t const hi = std::min(local_index_t(lo + block_size), num_cells);
+
+            for (local_index_t l = lo; l < hi; l++) {
+                if (cell_level(l)) {
+                    block_offsets(b, local_index_t(*cell_level(l)))++;
+                }
+            }
+        });
 
-        lopack_.modify_device();
-    }
+    // Scan the histograms in (level, block) order. At most MAX_LEVELS * concurrency entries, so
+    // this isn't worth threading.
+    lopack_.clear_sync_state();
 
-    // Fill out lpoint_
     {
-        Kokkos::View<local_index_t *, eap::HostMemorySpace> current_lo(
-            "eap::mesh::Kidmom::BuildPack::current_lo", num_levels_);
+        auto lopack = lopack_.view_host();
 
-        lopack_.sync_host();
+        local_index_t offset = 0;
+        for (local_index_t level = 0; level < num_levels; level++) {
+            lopack(level) = offset;
 
-        Kokkos::deep_copy(
-            current_lo,
-            Kokkos::subview(lopack_, Kokkos::make_pair(0, current_lo.extent_int(0))).view_host());
+            for (local_index_t b = 0; b < num_blocks; b++) {
+                auto const count = block_offsets(b, level);
+                block_offsets(b, level) = offset;
+                offset += count;
+            }
+        }
+        lopack(num_levels) = offset;
+    }
 
-        lpoint_.clear_sync_state();
+    lopack_.modify_host();
+    lopack_.sync_device();
 
-        {
-            auto lpoint = lpoint_.view_host();
+    // Scatter each block's cells into lpoint_
+    lpoint_.clear_sync_state();
 
-            for (local_index_t i = 0; i < cell_level.extent(0); i++) {
-                if (cell_level(i)) {
-                    lpoint(current_lo(local_index_t(*cell_level(i)))++) = i;
+    {
+        auto const lpoint = lpoint_.view_host();
+
+        Kokkos::parallel_for(
+            "eap::mesh::KidMom::BuildPack::fill_lpoint",
+            Kokkos::RangePolicy<HostExecSpace>(0, num_blocks),
+            KOKKOS_LAMBDA(local_index_t const b) {
+                local_index_t const lo = b * block_size;
+                local_index_t const hi = std::min(local_index_t(lo + block_size), num_cells);
+
+                for (local_index_t l = lo; l < hi; l++) {
+                    if (cell_level(l)) {
+                        lpoint(block_offsets(b, local_index_t(*cell_level(l)))++) = l;
+                    }
                 }
-            }
-        }
+            });
+    }
 
-        lpoint_.modify_host();
+    lpoint_.modify_host();
+
+    BuildSegments(cell_level_dual);
+
+    if (options_.level_major_renumbering) {
+        BuildRenumbering(cells, cell_level_dual);
     }
 
     EE_DIAG_POST
@@ -347,6 +426,9 @@ void KidMom::ReconMove(nonstd::span<FortranLocalIndex const> send_start,
                        nonstd::span<local_index_t const> recv_length) {
     EE_DIAG_PRE
 
+    // lpoint_ no longer describes the levels until the next BuildPack
+    segments_valid_ = false;
+
     ReconMovePattern pattern(send_start, send_length, recv_start, recv_length);
     pattern.Move(cell_mother_);
     pattern.Move(cell_daughter_);
@@ -403,6 +485,116 @@ void KidMom::CheckLoHiPackAndLevels(Cells const &cells,
     EE_DIAG_POST_MSG("Internal state of Levels is inconsistent")
 }
 
+void KidMom::BuildSegments(MeshDualView<OptionalFortranLocalIndex *> cell_level_dual) {
+    using HostExecSpace = Kokkos::DefaultHostExecutionSpace;
+
+    EE_DIAG_PRE
+
+    EE_ASSERT(!cell_level_dual.need_sync_host());
+    EE_ASSERT(!lopack_.need_sync_host());
+    EE_ASSERT(!lpoint_.need_sync_host());
+
+    auto const cell_level = cell_level_dual.view_host();
+    auto const lopack = lopack_.view_host();
+    auto const lpoint = lpoint_.view_host();
+    auto const num_levels = num_levels_;
+    local_index_t const num_packed = lopack(num_levels);
+
+    // Sized for the worst case of every cell being its own segment
+    if (lseg_.extent(0) < num_packed + 1) {
+        Kokkos::realloc(lseg_, num_packed + 1);
+    }
+    Kokkos::realloc(loseg_, num_levels + 1);
+
+    auto const lseg = lseg_;
+    auto const loseg = loseg_;
+
+    // A segment starts at the start of each level, and wherever lpoint_ skips a cell index
+    local_index_t num_segments = 0;
+    Kokkos::parallel_scan(
+        "eap::mesh::KidMom::BuildSegments",
+        Kokkos::RangePolicy<HostExecSpace>(0, num_packed),
+        KOKKOS_LAMBDA(local_index_t const lp, local_index_t &update, bool const is_final) {
+            local_index_t const l = lpoint(lp);
+            bool const level_start = lp == 0 || cell_level(l) != cell_level(lpoint(lp - 1));
+
+            if (level_start || l != local_index_t(lpoint(lp - 1)) + 1) {
+                if (is_final) {
+                    lseg(update) = lp;
+
+                    if (level_start) {
+                        loseg(local_index_t(*cell_level(l))) = update;
+                    }
+                }
+                update++;
+            }
+        },
+        num_segments);
+
+    lseg(num_segments) = num_packed;
+    loseg(num_levels) = num_segments;
+
+    // Empty levels have no segments, so they start where the next level starts
+    for (local_index_t level = num_levels; level-- > 0;) {
+        if (lopack(level) == lopack(level + 1)) {
+            loseg(level) = loseg(level + 1);
+        }
+    }
+
+    segments_valid_ = true;
+
+    EE_DIAG_POST
+}
+
+void KidMom::BuildRenumbering(Cells const &cells,
+                              MeshDualView<OptionalFortranLocalIndex *> cell_level_dual) {
+    using HostExecSpace = Kokkos::DefaultHostExecutionSpace;
+
+    EE_DIAG_PRE
+
+    EE_ASSERT(!cell_level_dual.need_sync_host());
+    EE_ASSERT(!lopack_.need_sync_host());
+    EE_ASSERT(!lpoint_.need_sync_host());
+
+    auto const num_cells = cells.num_local_cells();
+
+    Kokkos::realloc(renumber_new_to_old_, num_cells);
+    Kokkos::realloc(renumber_old_to_new_, num_cells);
+
+    auto const cell_level = cell_level_dual.view_host();
+    auto const new_to_old = renumber_new_to_old_;
+    auto const old_to_new = renumber_old_to_new_;
+    auto const lpoint = lpoint_.view_host();
+    local_index_t const num_with_level = lopack_.view_host()(num_levels_);
+
+    // lpoint_ is already grouped by level, and within a level is ordered by cell index, which keeps
+    // the spatial locality of the block ordering the cells were created in
+    Kokkos::parallel_for(
+        "eap::mesh::KidMom::BuildRenumbering::with_level",
+        Kokkos::RangePolicy<HostExecSpace>(0, num_with_level),
+        KOKKOS_LAMBDA(local_index_t const i) { new_to_old(i) = lpoint(i); });
+
+    // Cells without a level are placed after all of the other cells, in their current order
+    Kokkos::parallel_scan(
+        "eap::mesh::KidMom::BuildRenumbering::without_level",
+        Kokkos::RangePolicy<HostExecSpace>(0, num_cells),
+        KOKKOS_LAMBDA(local_index_t const l, local_index_t &update, bool const is_final) {
+            if (!cell_level(l)) {
+                if (is_final) {
+                    new_to_old(num_with_level + update) = l;
+                }
+                update++;
+            }
+        });
+
+    Kokkos::parallel_for(
+        "eap::mesh::KidMom::BuildRenumbering::invert",
+        Kokkos::RangePolicy<HostExecSpace>(0, num_cells),
+        KOKKOS_LAMBDA(local_index_t const i) { old_to_new(local_index_t(new_to_old(i))) = i; });
+
+    EE_DIAG_POST
+}
+
 bool KidMom::IsTop(Cells const &cells, local_index_t cell) const {
     return cells.IsActive(cell) && !cell_daughter_(cell);
 }
@@ -34,6 +34,37 @@ using Kokkos::parallel_for;
 using Kokkos::RangePolicy;
 using Kokkos::subview;
 
+namespace {
+/**
+ * @brief Scan functor that finds the index in ltop where the contiguous run of cells containing
+ * each entry starts. Uses a max-join, since run starts only ever increase.
+ */
+struct RunStartScan {
+    using value_type = local_index_t;
+
+    MeshView<FortranLocalIndex const *> ltop;
+    MeshView<local_index_t *> run_start;
+
+    KOKKOS_INLINE_FUNCTION void init(value_type &update) const { update = 0; }
+
+    KOKKOS_INLINE_FUNCTION void join(value_type volatile &update,
+                                     value_type const volatile &input) const {
+        if (input > update) update = input;
+    }
+
+    KOKKOS_INLINE_FUNCTION void
+    operator()(local_index_t const i, value_type &update, bool const is_final) const {
+        if (i > 0 && local_index_t(ltop(i)) != local_index_t(ltop(i - 1)) + 1) {
+            update = i;
+        }
+
+        if (is_final) {
+            run_start(i) = update;
+        }
+    }
+};
+} // namespace
+
 Levels::Levels()
     : cell_level_("Levels::cell_level", 0),
       area_("Levels::area"),
@@ -245,12 +276,7 @@ void Levels::BuildPack(Cells const &cells) {
     kid_mom_.BuildPack(cells, cell_level_);
 }
 
-void Levels::BuildTop(Cells const &cells) {
-    auto tops = kid_mom_.BuildTop(cells);
-
-    num_top_ = tops.first;
-    sum_num_top_ = tops.second;
-}
+void Levels::BuildTop(Cells const &cells) { num_top_ = kid_mom_.BuildTop(cells); }
 
 void Levels::SetupAllTop(Cells const &cells) {
     all_num_top_ = kid_mom_.SetupAllTop(cells, num_top_);
@@ -260,6 +286,14 @@ void Levels::SetupAllTop(Cells const &cells) {
 
     chunk_count_ = generated_chunks.chunk_count;
     chunk_ids_ = std::move(generated_chunks.chunk_ids);
+
+    // The global top cell count reduction started in BuildTop overlaps with the work above
+    sum_num_top_ = kid_mom_.WaitSumNumTop();
+}
+
+global_index_t Levels::SumNumTop() {
+    sum_num_top_ = kid_mom_.WaitSumNumTop();
+    return sum_num_top_;
 }
 
 void Levels::ReconMove(local_index_t data_length,
@@ -445,104 +479,54 @@ void Levels::SetLevelMaxFromTuples(
 
 // ---- Level Private Routines ----
 
-local_index_t Levels::CountChunks(Cells const &cells) const {
-    if (all_num_top_ <= 0) {
-        return 0;
-    }
-
-    auto const &ltop = kid_mom_.ltop();
-
-    local_index_t run_count = 0;
-
-    {
-        local_index_t lastl = ltop(0);
-        local_index_t run_length = 1;
-        for (local_index_t i = 1; i < num_top_; i++) {
-            if (ltop(i) == lastl + 1 && run_length < ELEM_MAX) {
-                run_length++;
-            } else {
-                run_count++;
-
-                run_length = 1;
-            }
-
-            lastl = ltop(i);
-        }
-    }
-
-    run_count++;
-
-    if (cells.num_clone_cells() > 0) {
-        local_index_t const diff = cells.num_clone_cells();
-        local_index_t const quot = diff / ELEM_MAX;
-
-        run_count += quot;
-        if (quot * ELEM_MAX < diff) {
-            run_count++;
-        }
-    }
-
-    return run_count;
-}
-
-std::vector<std::array<local_index_t, 2>> Levels::PopulateChunks(Cells const &cells) const {
-    using std::min;
-
-    if (all_num_top_ <= 0) {
-        return {};
-    }
-
-    local_index_t const num_chunks = CountChunks(cells);
-
-    std::vector<std::array<local_index_t, 2>> chunks;
-    chunks.reserve(num_chunks);
-
-    auto const &ltop = kid_mom_.ltop();
-
-    local_index_t lastl = ltop(0);
-    local_index_t run_length = 1;
-
-    local_index_t chunk_start = lastl;
-    for (local_index_t i = 1; i < num_top_; i++) {
-        if (ltop(i) != lastl + 1 || run_length == ELEM_MAX) {
-            chunks.push_back({chunk_start, lastl});
-            chunk_start = ltop(i);
-
-            run_length = 1;
-        } else {
-            run_length++;
-        }
-
-        lastl = ltop(i);
-    }
-    chunks.push_back({chunk_start, lastl});
-
-    for (local_index_t ci = cells.num_local_cells() + 1; ci < cells.num_local_cells_with_clones();
-         ci++) {
-        chunks.push_back(
-            {ci, min(local_index_t(ci + ELEM_MAX - 1), cells.num_local_cells_with_clones())});
-    }
-
-    return chunks;
-}
-
 Levels::GeneratedChunks Levels::GenerateChunkIds(Cells const &cells) const {
+    using HostExecSpace = Kokkos::DefaultHostExecutionSpace;
+
     if (cells.num_local_cells() <= 0) {
-        return {0, MeshView<utility::FortranIndex<local_index_t> *>("Levels::chunk_ids", 0)};
+        return {0, MeshView<FortranLocalIndex *>("Levels::chunk_ids", 0)};
     }
 
-    MeshView<utility::FortranIndex<local_index_t> *> chunk_ids("Levels::chunk_ids",
-                                                               cells.num_local_cells_with_clones());
+    local_index_t const num_top = num_top_;
+    local_index_t const num_local_cells = cells.num_local_cells();
+    local_index_t const num_local_cells_with_clones = cells.num_local_cells_with_clones();
+    local_index_t const num_clone_chunks = (cells.num_clone_cells() + ELEM_MAX - 1) / ELEM_MAX;
+
+    auto const ltop = kid_mom_.ltop_;
+
+    MeshView<FortranLocalIndex *> chunk_ids("Levels::chunk_ids", num_local_cells_with_clones);
+
+    // Find the start of the contiguous run of cells in ltop that each entry belongs to
+    MeshView<local_index_t *> run_start("Levels::GenerateChunkIds::run_start", num_top);
+    Kokkos::parallel_scan("Levels::GenerateChunkIds::run_start",
+                          Kokkos::RangePolicy<HostExecSpace>(0, num_top),
+                          RunStartScan{ltop, run_start});
+
+    // Runs are split into chunks of at most ELEM_MAX cells, measured from the start of the run.
+    // Each chunk start is numbered by a sum scan, which also fills chunk_ids.
+    local_index_t num_top_chunks = 0;
+    Kokkos::parallel_scan(
+        "Levels::GenerateChunkIds::top_chunks",
+        Kokkos::RangePolicy<HostExecSpace>(0, num_top),
+        KOKKOS_LAMBDA(local_index_t const i, local_index_t &update, bool const is_final) {
+            if ((i - run_start(i)) % ELEM_MAX == 0) {
+                update++;
+            }
 
-    auto chunks = PopulateChunks(cells);
+            if (is_final) {
+                chunk_ids(ltop(i)) = update - 1;
+            }
+        },
+        num_top_chunks);
 
-    for (local_index_t ci = 0; ci < chunks.size(); ci++) {
-        for (local_index_t l = chunks[ci][0]; l <= chunks[ci][1]; l++) {
-            chunk_ids(l) = ci;
-        }
-    }
+    // Clone cells are always contiguous, so they're split into fixed-size chunks
+    Kokkos::parallel_for(
+        "Levels::GenerateChunkIds::clone_chunks",
+        Kokkos::RangePolicy<HostExecSpace>(num_local_cells, num_local_cells_with_clones),
+        KOKKOS_LAMBDA(local_index_t const l) {
+            chunk_ids(l) = num_top_chunks + (l - num_local_cells) / ELEM_MAX;
+        });
 
-    return GeneratedChunks{local_index_t(chunks.size()), chunk_ids};
+    return GeneratedChunks{num_top_chunks + num_clone_chunks, chunk_ids};
 }
 
 template <typename Collection>
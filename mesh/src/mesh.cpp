@@ -11,10 +11,12 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <numeric>
 #include <vector>
 
+#include "mesh-blocks_compute.hpp"
 #include "mesh-internal-log.hpp"
 
 using namespace eap::mesh;
@@ -35,6 +37,18 @@ void MeshBuilder::set_rank_weights(std::vector<double> &&weights) {
         comm_.abort(EXIT_FAILURE);
     }
 
+    if (std::any_of(weights.begin(), weights.end(), [](auto weight) {
+            return !std::isfinite(weight) || weight < 0.0;
+        })) {
+        mesh_err() << "Rank weights must be finite and non-negative." << std::endl;
+        comm_.abort(EXIT_FAILURE);
+    }
+
+    if (!(std::accumulate(weights.begin(), weights.end(), 0.0) > 0.0)) {
+        mesh_err() << "At least one rank weight must be positive." << std::endl;
+        comm_.abort(EXIT_FAILURE);
+    }
+
     rank_weights_ = std::move(weights);
 }
 
@@ -72,56 +86,131 @@ void MeshBuilder::set_global_extents(std::initializer_list<global_index_t> exten
     assert((num_global_cells() % block_size()) == 0);
 }
 
-Mesh MeshBuilder::build() {
-    if (global_extents_.end() == std::find(global_extents_.begin(), global_extents_.end(), 0)) {
-        mesh_err()
-            << "MeshBuilder::set_global_extents must be called prior to calling MeshBuilder::build"
-            << std::endl;
-        comm_.abort(EXIT_FAILURE);
-    }
-
-    /* TODO complete this implementation
-    auto const num_global_cells = this->num_global_cells();
+std::vector<global_index_t> MeshBuilder::block_partition() const {
+    auto const num_ranks = static_cast<size_t>(comm_.size());
     auto const num_global_blocks = this->num_global_blocks();
 
-    std::vector<uint32_t> num_blocks_per_rank(comm_.size());
+    std::vector<global_index_t> block_start(num_ranks + 1, 0);
     if (rank_weights_.empty()) {
-        auto const local_blocks = num_global_blocks / comm_.size();
-        auto const remainder = (num_global_blocks % comm_.size());
         // distribute the blocks as evenly as possible.
-        for (mpi::rank_t rank = 0; rank < comm_.size(); rank++) {
-            num_blocks_per_rank[rank] = local_blocks + (rank < (mpi::rank_t)remainder);
+        auto const local_blocks = num_global_blocks / num_ranks;
+        auto const remainder = num_global_blocks % num_ranks;
+        for (size_t rank = 0; rank < num_ranks; rank++) {
+            block_start[rank + 1] = block_start[rank] + local_blocks + (rank < remainder);
         }
-    } else {
-        mesh_err() << "rank_weights UNIMPLEMENTED!" << std::endl;
-        comm_.abort(EXIT_FAILURE);
+        return block_start;
     }
 
-    auto const block_start = std::accumulate(num_blocks_per_rank.begin(),
-                                             num_blocks_per_rank.begin() + comm_.rank(),
-                                             0ul,
-                                             std::plus<uint32_t>());
-
-    auto const num_local_blocks = num_blocks_per_rank[comm_.rank()];
-
-    auto const block_end = block_start + num_local_blocks;
+    // Cut the curve where the running sum of the weights crosses each rank's share. Rounding the
+    // cumulative share, rather than each rank's own share, keeps the total exact.
+    auto const total_weight = std::accumulate(rank_weights_.begin(), rank_weights_.end(), 0.0);
 
-    auto const num_local_cells = num_local_blocks * block_size();
+    double prefix_weight = 0.0;
+    for (size_t rank = 0; rank < num_ranks; rank++) {
+        prefix_weight += rank_weights_[rank];
+        auto const cut = static_cast<global_index_t>(
+            std::llround(static_cast<double>(num_global_blocks) * (prefix_weight / total_weight)));
+        block_start[rank + 1] = std::min(std::max(cut, block_start[rank]), num_global_blocks);
+    }
+    block_start[num_ranks] = num_global_blocks;
 
-    assert(!num_blocks_per_rank.empty());
+    return block_start;
+}
 
-    auto const max_num_blocks =
-        *std::max_element(num_blocks_per_rank.begin(), num_blocks_per_rank.end());
+Mesh MeshBuilder::build() {
+    if (global_extents_.end() != std::find(global_extents_.begin(), global_extents_.end(), 0)) {
+        mesh_err()
+            << "MeshBuilder::set_global_extents must be called prior to calling MeshBuilder::build"
+            << std::endl;
+        comm_.abort(EXIT_FAILURE);
+    }
 
-    auto const max_num_cells = max_num_blocks * block_size();
+    using ExecutionSpace = Kokkos::DefaultHostExecutionSpace;
+
+    auto const rank = static_cast<size_t>(comm_.rank());
+    auto const block_size = this->block_size();
+    auto const num_extents = num_extents_;
+
+    auto const block_start = block_partition();
+    auto const first_block = block_start[rank];
+    auto const num_local_blocks = block_start[rank + 1] - first_block;
+    auto const num_local_cells = num_local_blocks * block_size;
+
+    Mesh mesh;
+    mesh.comm_ = comm_;
+    mesh.num_extents_ = num_extents_;
+    mesh.global_extents_ = global_extents_;
+
+    mesh.global_base_address_.resize(block_start.size());
+    std::transform(block_start.begin(),
+                   block_start.end(),
+                   mesh.global_base_address_.begin(),
+                   [block_size](auto const block) { return block * block_size; });
+
+    // Find where each local block sits in the global block grid
+    auto const block_extents = global_block_extents();
+    BlockLayout const layout(
+        block_layout_method_, block_extents[0], block_extents[1], block_extents[2]);
+
+    MeshView<global_index_t *> block_addresses(
+        Kokkos::ViewAllocateWithoutInitializing("MeshBuilder::build::block_addresses"),
+        num_local_blocks);
+    MeshView<global_index_t **> block_coordinates(
+        Kokkos::ViewAllocateWithoutInitializing("MeshBuilder::build::block_coordinates"),
+        num_local_blocks,
+        3);
+
+    Kokkos::parallel_for("MeshBuilder::build::block_addresses",
+                         Kokkos::RangePolicy<ExecutionSpace>(0, num_local_blocks),
+                         KOKKOS_LAMBDA(global_index_t const b) {
+                             block_addresses(b) = first_block + b;
+                         });
+
+    GetBlockCoordinates<ExecutionSpace>(layout, block_addresses, block_coordinates);
+
+    // Expand each block into its cells. Bit d of a cell's offset within its block is its offset
+    // in dimension d.
+    mesh.cell_coordinates_ = MeshView<global_index_t **>(
+        Kokkos::ViewAllocateWithoutInitializing("Mesh::cell_coordinates_"), num_local_cells, 3);
+    auto const cell_coordinates = mesh.cell_coordinates_;
+
+    Kokkos::parallel_for("MeshBuilder::build::cell_coordinates",
+                         Kokkos::RangePolicy<ExecutionSpace>(0, num_local_cells),
+                         KOKKOS_LAMBDA(global_index_t const l) {
+                             auto const b = l / block_size;
+                             auto const s = l % block_size;
+                             for (int d = 0; d < 3; d++) {
+                                 cell_coordinates(l, d) =
+                                     d < num_extents
+                                         ? 2 * block_coordinates(b, d) + ((s >> d) & 1)
+                                         : 0;
+                             }
+                         });
+
+    // The local extents are the box bounding the local cells
+    for (int d = 0; d < 3; d++) {
+        if (num_local_cells == 0) {
+            mesh.local_lo_[d] = 0;
+            mesh.local_extents_[d] = 0;
+            continue;
+        }
 
-    auto const global_block_extents = this->global_block_extents();
-    for (auto block = block_start; block != block_end; block++) {
-        auto const block_i = block % global_block_extents[0];
+        Kokkos::MinMaxScalar<global_index_t> bounds;
+        Kokkos::parallel_reduce("MeshBuilder::build::local_extents",
+                                Kokkos::RangePolicy<ExecutionSpace>(0, num_local_cells),
+                                KOKKOS_LAMBDA(global_index_t const l,
+                                              Kokkos::MinMaxScalar<global_index_t> &update) {
+                                    auto const x = cell_coordinates(l, d);
+                                    if (x < update.min_val) update.min_val = x;
+                                    if (x > update.max_val) update.max_val = x;
+                                },
+                                Kokkos::MinMax<global_index_t>(bounds));
+
+        mesh.local_lo_[d] = bounds.min_val;
+        mesh.local_extents_[d] = static_cast<local_index_t>(bounds.max_val - bounds.min_val + 1);
     }
-    */
 
-    return Mesh();
+    return mesh;
 }
 
 Mesh Mesh::from_global_2d_dimensions(mpi::Comm *comm, global_index_t x, global_index_t y) {
@@ -0,0 +1,186 @@
+/**
+ * @file balance-test.cpp
+ *
+ * @brief Tests mesh-balance
+ * @date 2019-09-20
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+// STL Includes
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+// Third Party Includes
+#include <gtest/gtest.h>
+
+// Internal Includes
+#include <comm-patterns.hpp>
+#include <comm-token.hpp>
+#include <mesh-balance.hpp>
+#include <mesh-cells.hpp>
+#include <utility-linear_view.hpp>
+
+using eap::local_index_t;
+using eap::comm::TokenBuilder;
+using eap::mesh::BlockLayoutMethod;
+using eap::mesh::Cells;
+using eap::mesh::MeshView;
+using eap::utility::MakeLinearView;
+
+namespace {
+/**
+ * @brief Sets up an uneven number of cells on each rank, all on one strip of a 2D grid
+ */
+void SetupCells(Cells &cells, local_index_t num_local_cells) {
+    cells.SetNumLocalCells(num_local_cells);
+    cells.ResizeCellArrays(num_local_cells, 2);
+
+    auto const rank = mpi::Comm::world().rank();
+    auto const cell_center = cells.cell_center();
+    for (local_index_t l = 0; l < num_local_cells; l++) {
+        cell_center(l, 0) = 0.5 + (l % 16);
+        cell_center(l, 1) = 0.5 + rank * 64 + (l / 16);
+    }
+}
+} // namespace
+
+TEST(Balance, Counts) {
+    auto comm = mpi::Comm::world();
+    auto builder = TokenBuilder::FromComm(comm);
+    Cells cells(builder);
+
+    local_index_t const num_local_cells = 16 * (1 + 3 * comm.rank());
+    SetupCells(cells, num_local_cells);
+
+    MeshView<double *> weights("weights", num_local_cells);
+
+    auto const balance = eap::mesh::BalanceAlongCurve(cells, 2, weights, BlockLayoutMethod::Morton);
+
+    ASSERT_EQ(num_local_cells,
+              std::accumulate(
+                  balance.send_length.begin(), balance.send_length.end(), local_index_t(0)));
+
+    // Without weights, cells are balanced by count
+    double const num_global_cells = 16.0 * comm.size() * (3 * comm.size() - 1) / 2.0;
+    ASSERT_NEAR(num_global_cells / comm.size(), balance.new_num_local_cells, 1.0);
+
+    // The plan is a permutation of the local cells
+    std::vector<bool> seen(num_local_cells, false);
+    for (local_index_t i = 0; i < num_local_cells; i++) {
+        local_index_t const l = balance.renumber_new_to_old(i);
+        ASSERT_FALSE(seen[l]);
+        seen[l] = true;
+    }
+}
+
+TEST(Balance, Weights) {
+    auto comm = mpi::Comm::world();
+    auto builder = TokenBuilder::FromComm(comm);
+    Cells cells(builder);
+
+    local_index_t const num_local_cells = 16 * (2 + comm.rank());
+    SetupCells(cells, num_local_cells);
+
+    // Cells to the right are more expensive
+    MeshView<double *> weights("weights", num_local_cells);
+    auto const cell_center = cells.cell_center();
+    for (local_index_t l = 0; l < num_local_cells; l++) {
+        weights(l) = 1.0 + cell_center(l, 0);
+    }
+
+    std::vector<double> all_weights(comm.size());
+    comm.all_gather(std::accumulate(weights.data(), weights.data() + num_local_cells, 0.0),
+                    nonstd::span<double>(all_weights));
+    auto const global_weight = std::accumulate(all_weights.begin(), all_weights.end(), 0.0);
+
+    auto const balance = eap::mesh::BalanceAlongCurve(cells, 2, weights);
+
+    // Move the weights along with the cells
+    balance.ApplyRenumbering(weights);
+
+    MeshView<double *> moved("moved", balance.new_num_local_cells);
+    {
+        auto const linear_weights = MakeLinearView(weights);
+        auto linear_moved = MakeLinearView(moved);
+
+        eap::comm::Move<double>(comm,
+                                balance.send_start,
+                                balance.send_length,
+                                linear_weights.Span(),
+                                balance.recv_start,
+                                balance.recv_length,
+                                linear_moved.Span());
+    }
+
+    // Each rank is within one cell's weight of its share
+    double const local_weight =
+        std::accumulate(moved.data(), moved.data() + balance.new_num_local_cells, 0.0);
+    ASSERT_NEAR(global_weight / comm.size(), local_weight, 17.0);
+}
+
+TEST(Balance, ContiguousRanges) {
+    auto comm = mpi::Comm::world();
+    auto builder = TokenBuilder::FromComm(comm);
+    Cells cells(builder);
+
+    // Every rank starts with cells from along the whole line, so only a cut in global curve order
+    // leaves each rank with one piece of it
+    local_index_t const num_local_cells = 16 * (1 + comm.rank());
+    cells.SetNumLocalCells(num_local_cells);
+    cells.ResizeCellArrays(num_local_cells, 1);
+
+    auto const cell_center = cells.cell_center();
+    for (local_index_t l = 0; l < num_local_cells; l++) {
+        cell_center(l, 0) = 0.5 + comm.rank() + l * comm.size();
+    }
+
+    MeshView<double *> weights("weights", num_local_cells);
+    for (local_index_t l = 0; l < num_local_cells; l++) {
+        weights(l) = 1.0 + (l % 3);
+    }
+
+    auto const balance = eap::mesh::BalanceAlongCurve(cells, 1, weights, BlockLayoutMethod::Morton);
+
+    // In one dimension the curve key increases with x, so the keys each rank receives form one
+    // contiguous range when the ranks hold disjoint, increasing intervals of x
+    MeshView<double *> x("x", num_local_cells);
+    for (local_index_t l = 0; l < num_local_cells; l++) {
+        x(l) = cell_center(l, 0);
+    }
+    balance.ApplyRenumbering(x);
+
+    MeshView<double *> moved("moved", balance.new_num_local_cells);
+    {
+        auto const linear_x = MakeLinearView(x);
+        auto linear_moved = MakeLinearView(moved);
+
+        eap::comm::Move<double>(comm,
+                                balance.send_start,
+                                balance.send_length,
+                                linear_x.Span(),
+                                balance.recv_start,
+                                balance.recv_length,
+                                linear_moved.Span());
+    }
+
+    auto const range = std::minmax_element(moved.data(), moved.data() + moved.extent(0));
+    bool const has_cells = balance.new_num_local_cells > 0;
+
+    std::vector<double> all_min(comm.size());
+    std::vector<double> all_max(comm.size());
+    comm.all_gather(has_cells ? *range.first : 0.0, nonstd::span<double>(all_min));
+    comm.all_gather(has_cells ? *range.second : 0.0, nonstd::span<double>(all_max));
+
+    std::vector<local_index_t> all_counts(comm.size());
+    comm.all_gather(balance.new_num_local_cells, nonstd::span<local_index_t>(all_counts));
+
+    double previous_max = -1.0;
+    for (int r = 0; r < comm.size(); r++) {
+        if (all_counts[r] == 0) continue;
+
+        ASSERT_LT(previous_max, all_min[r]) << "rank " << r << " overlaps an earlier rank";
+        previous_max = all_max[r];
+    }
+}
@@ -7,14 +7,23 @@
  * @copyright Copyright (C) 2019 Triad National Security, LLC
  */
 
+// STL Includes
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 // Third Party Includes
 #include <gtest/gtest.h>
 
 // Internal Includes
+#include <comm-token.hpp>
+#include <mesh-cells.hpp>
 #include <mesh-dzn_compute.hpp>
 
 using namespace eap;
 
+using eap::comm::TokenBuilder;
+using eap::mesh::Cells;
 using eap::mesh::Coordinates;
 using eap::mesh::DefinedZoneResolutionInfo;
 using eap::mesh::Kode;
@@ -55,6 +64,53 @@ TEST(DZN, Basic) {
 
     // Outside of DZNs, nullopt is returned
     ASSERT_EQ(nonstd::nullopt, eap::mesh::FindDZN(dzn, 1, 0.0, Coordinates<double>{3.0}));
+
+    // The array version agrees with the single point version
+    Kokkos::View<double **, Kokkos::LayoutLeft, eap::HostMemorySpace> points("points", 3, 1);
+    points(0, 0) = 0.75;
+    points(1, 0) = -1.5;
+    points(2, 0) = 3.0;
+
+    Kokkos::View<eap::utility::OptionalInteger<local_index_t> *, eap::HostMemorySpace> found(
+        "found", 3);
+    eap::mesh::FindDZNs(dzn, 1, 0.0, points, found);
+
+    ASSERT_EQ(1u, *found(0));
+    ASSERT_EQ(0u, *found(1));
+    ASSERT_FALSE(found(2));
+
+    Kokkos::View<local_index_t *, eap::HostMemorySpace> level_base("level_base", 3);
+    Kokkos::View<local_index_t *, eap::HostMemorySpace> level_set("level_set", 3);
+    Kokkos::deep_copy(level_set, 7);
+    eap::mesh::SplitDZNs(dzn, 1, 0.0, points, level_base, level_set);
+
+    ASSERT_EQ(2u, level_set(0));
+    ASSERT_EQ(4u, level_set(1));
+    ASSERT_EQ(7u, level_set(2));
+
+    // Evaluating in the default execution space's own memory gives the same levels
+    using DeviceSpace = Kokkos::DefaultExecutionSpace::memory_space;
+
+    auto const device_points = Kokkos::create_mirror_view(DeviceSpace(), points);
+    Kokkos::deep_copy(device_points, points);
+
+    Kokkos::View<local_index_t *, DeviceSpace> device_level_base("device_level_base", 3);
+    Kokkos::View<local_index_t *, DeviceSpace> device_level_set("device_level_set", 3);
+    Kokkos::deep_copy(device_level_set, 7);
+    eap::mesh::SplitDZNsWithFilter<Kokkos::DefaultExecutionSpace, DeviceSpace>(
+        dzn,
+        1,
+        0.0,
+        device_points,
+        device_level_base,
+        device_level_set,
+        [](local_index_t, ZoneOptions const &) { return true; });
+
+    auto const device_level_set_host = Kokkos::create_mirror_view(device_level_set);
+    Kokkos::deep_copy(device_level_set_host, device_level_set);
+    for (local_index_t i = 0; i < 3; i++) {
+        ASSERT_EQ(level_set(i), device_level_set_host(i));
+    }
 }
 
 TEST(DZN, Circle) {
@@ -101,4 +157,266 @@ TEST(DZN, Circle) {
     // At time >= 2.5, outer_point and inner_point are both in INNER_CIRCLE
     ASSERT_EQ(INNER_CIRCLE, eap::mesh::FindDZN(dzn, 2, 2.6, inner_point));
     ASSERT_EQ(INNER_CIRCLE, eap::mesh::FindDZN(dzn, 2, 2.6, outer_point));
-}
\ No newline at end of file
+}
+
+TEST(DZN, ProcessCells) {
+    ZoneOptions options;
+    options.add = false;
+    options.kode = Kode::Unconditional;
+    options.outer = false;
+    options.use = ZoneShape::BricksAndRectangles;
+
+    DefinedZoneResolutionInfo dzn;
+
+    NewDzn brick;
+    brick.level = 3;
+    brick.x = Kokkos::make_pair(-2.0, 2.0);
+    brick.y = Kokkos::make_pair(-2.0, 2.0);
+    brick.options.SetOptions(options);
+    dzn.Push(brick);
+
+    options.use = ZoneShape::SpheresAndCircles;
+
+    NewDzn circle;
+    circle.level = 5;
+    circle.r = Kokkos::make_pair(1.0, 1.0);
+    circle.options.SetOptions(options);
+    dzn.Push(circle);
+
+    options.add = true;
+    options.outer = true;
+    options.use = ZoneShape::BricksAndRectangles;
+
+    NewDzn outside;
+    outside.level = -1;
+    outside.x = Kokkos::make_pair(-3.0, 3.0);
+    outside.y = Kokkos::make_pair(-3.0, 3.0);
+    outside.options.SetOptions(options);
+    dzn.Push(outside);
+
+    auto builder = TokenBuilder::FromComm(mpi::Comm::world());
+    Cells cells(builder);
+
+    constexpr local_index_t num_cells = 81;
+    cells.SetNumLocalCells(num_cells);
+    cells.ResizeCellArrays(num_cells, 2);
+
+    auto const cell_center = cells.cell_center();
+    for (local_index_t l = 0; l < num_cells; l++) {
+        cell_center(l, 0) = -4.0 + (l % 9);
+        cell_center(l, 1) = -4.0 + (l / 9);
+    }
+
+    Kokkos::View<local_index_t *, eap::HostMemorySpace> level_base("level_base", num_cells);
+    Kokkos::View<local_index_t *, eap::HostMemorySpace> level_set("level_set", num_cells);
+    Kokkos::deep_copy(level_base, 4);
+    Kokkos::deep_copy(level_set, 1);
+
+    eap::mesh::ProcessCellsInDZNFilterKode(
+        dzn, 2, cells, 0.0, Kode::Unconditional, 0, num_cells, level_base, level_set);
+
+    // Every cell gets the level of the final DZN that matches its center: 3 outside of the
+    // outer brick (4 - 1), 5 in the unit circle, 3 in the inner brick, otherwise unchanged.
+    // Rows are y = -4 to 4, columns x = -4 to 4.
+    local_index_t const expected[num_cells] = {
+        3, 3, 3, 3, 3, 3, 3, 3, 3, //
+        3, 1, 1, 1, 1, 1, 1, 1, 3, //
+        3, 1, 3, 3, 3, 3, 3, 1, 3, //
+        3, 1, 3, 3, 5, 3, 3, 1, 3, //
+        3, 1, 3, 5, 5, 5, 3, 1, 3, //
+        3, 1, 3, 3, 5, 3, 3, 1, 3, //
+        3, 1, 3, 3, 3, 3, 3, 1, 3, //
+        3, 1, 1, 1, 1, 1, 1, 1, 3, //
+        3, 3, 3, 3, 3, 3, 3, 3, 3  //
+    };
+
+    for (local_index_t l = 0; l < num_cells; l++) {
+        ASSERT_EQ(expected[l], level_set(l)) << "l = " << l;
+    }
+}
+
+namespace {
+struct ReferenceZone {
+    ZoneOptions options;
+    NewDzn zone;
+};
+
+/**
+ * @brief Computes the level DZN processing sets for the 2D point (`x`, `y`) straight from the
+ * definition of each shape, walking the DZNs in order so that the last match wins.
+ */
+local_index_t ReferenceLevel(std::vector<ReferenceZone> const &zones,
+                             double time,
+                             double x,
+                             double y,
+                             local_index_t level_base,
+                             local_index_t level_set) {
+    auto const at_time = [time](Kokkos::pair<double, double> const &range,
+                                Kokkos::pair<double, double> const &delta) {
+        return Kokkos::make_pair(range.first + delta.first * time,
+                                 range.second + delta.second * time);
+    };
+    auto const zero = Kokkos::make_pair(0.0, 0.0);
+
+    nonstd::optional<ReferenceZone> last_match;
+    for (auto const &reference : zones) {
+        auto const &zone = reference.zone;
+        auto const xr = at_time(zone.x.value_or(zero), zone.xd.value_or(zero));
+        auto const yr = at_time(zone.y.value_or(zero), zone.yd.value_or(zero));
+        auto const rr = at_time(zone.r.value_or(zero), zone.rd.value_or(zero));
+
+        bool inside = false;
+        bool valid = true;
+        switch (reference.options.use) {
+        case ZoneShape::BricksAndRectangles:
+            inside = x >= xr.first && x <= xr.second && y >= yr.first && y <= yr.second;
+            break;
+        case ZoneShape::SpheresAndCircles: {
+            // Centered on the start of the x and y ranges
+            double const dist2 = (x - xr.first) * (x - xr.first) + (y - yr.first) * (y - yr.first);
+            inside = rr.second > rr.first
+                         ? dist2 >= rr.first * rr.first && dist2 <= rr.second * rr.second
+                         : dist2 <= rr.first * rr.first;
+            break;
+        }
+        case ZoneShape::ConesAndWedges:
+        case ZoneShape::Cylinder: {
+            // The axis runs from the start to the end of the x and y ranges
+            double const ax = xr.second - xr.first;
+            double const ay = yr.second - yr.first;
+            double const axis2 = ax * ax + ay * ay;
+            double const px = x - xr.first;
+            double const py = y - yr.first;
+            double const s = (ax * px + ay * py) * (1.0 / axis2);
+            double const dist2 = (s * ax - px) * (s * ax - px) + (s * ay - py) * (s * ay - py);
+
+            if (reference.options.use == ZoneShape::ConesAndWedges) {
+                valid = rr.first >= 0.0 && rr.second >= 0.0 && axis2 > 0.0;
+                double const radius = rr.first + s * (rr.second - rr.first);
+                inside = s >= 0.0 && s <= 1.0 && dist2 <= radius * radius;
+            } else {
+                valid = rr.first >= 0.0 && rr.second > rr.first && axis2 > 0.0;
+                inside = s >= 0.0 && s <= 1.0 && dist2 >= rr.first * rr.first &&
+                         dist2 <= rr.second * rr.second;
+            }
+            break;
+        }
+        }
+
+        if (valid && inside != reference.options.outer) {
+            last_match = reference;
+        }
+    }
+
+    if (last_match) {
+        auto const level = *last_match->zone.level;
+        if (last_match->options.add) {
+            if (level != 0) {
+                return std::max<local_diff_t>(1, level_base + level);
+            }
+        } else if (level > 0) {
+            return level;
+        }
+    }
+
+    return level_set;
+}
+} // namespace
+
+TEST(DZN, ProcessCellsManyZones) {
+    DefinedZoneResolutionInfo dzn;
+    std::vector<ReferenceZone> reference_zones;
+
+    // Scatter small DZNs of each shape over the domain so that the cells are binned
+    for (int i = 0; i < 24; i++) {
+        ZoneOptions options;
+        options.add = (i % 5) == 0;
+        options.kode = Kode::Unconditional;
+        options.outer = (i == 7);
+        options.use = static_cast<ZoneShape>(i % 4);
+
+        double const cx = -40.0 + 3.5 * i;
+        double const cy = 30.0 - 2.5 * i;
+
+        NewDzn zone;
+        zone.level = options.add ? -2 : 2 + (i % 6);
+        zone.r = Kokkos::make_pair(0.5 + (i % 3), 4.0 + (i % 4));
+        zone.x = Kokkos::make_pair(cx, cx + 6.0 + (i % 3));
+        zone.xd = Kokkos::make_pair(1.0, 1.0);
+        zone.y = Kokkos::make_pair(cy, cy + 4.0 - (i % 5));
+        zone.options.SetOptions(options);
+        dzn.Push(zone);
+        reference_zones.push_back({options, zone});
+    }
+
+    auto builder = TokenBuilder::FromComm(mpi::Comm::world());
+    Cells cells(builder);
+
+    local_index_t const num_cells = 100 * 100;
+    cells.SetNumLocalCells(num_cells);
+    cells.ResizeCellArrays(num_cells, 2);
+
+    auto const cell_center = cells.cell_center();
+    for (local_index_t l = 0; l < num_cells; l++) {
+        cell_center(l, 0) = -50.0 + (l % 100) + 0.5;
+        cell_center(l, 1) = -50.0 + (l / 100) + 0.5;
+    }
+
+    Kokkos::View<local_index_t *, eap::HostMemorySpace> level_base("level_base", num_cells);
+    Kokkos::View<local_index_t *, eap::HostMemorySpace> level_set("level_set", num_cells);
+    Kokkos::deep_copy(level_base, 4);
+    Kokkos::deep_copy(level_set, 1);
+
+    double const time = 1.5;
+    eap::mesh::ProcessCellsInDZNFilterKode(
+        dzn, 2, cells, time, Kode::Unconditional, 0, num_cells, level_base, level_set);
+
+    for (local_index_t l = 0; l < num_cells; l++) {
+        auto const expected =
+            ReferenceLevel(reference_zones, time, cell_center(l, 0), cell_center(l, 1), 4, 1);
+        ASSERT_EQ(expected, level_set(l)) << "l = " << l;
+    }
+}
+
+TEST(DZN, BinZonesThinSlab) {
+    ZoneOptions options;
+    options.add = false;
+    options.kode = Kode::Unconditional;
+    options.outer = false;
+    options.use = ZoneShape::BricksAndRectangles;
+
+    DefinedZoneResolutionInfo dzn;
+
+    NewDzn zone;
+    zone.level = 3;
+    zone.x = Kokkos::make_pair(10.0, 20.0);
+    zone.y = Kokkos::make_pair(30.0, 40.0);
+    zone.z = Kokkos::make_pair(-1.0, 1.0);
+    zone.options.SetOptions(options);
+    dzn.Push(zone);
+
+    auto const zones = eap::mesh::internal::CompileDZNs(dzn, 3, 0.0, {0});
+
+    // Nearly flat in z, so x and y would each get as many bins as the whole grid is allowed
+    Kokkos::Array<double, 3> const lo{0.0, 0.0, 0.0};
+    Kokkos::Array<double, 3> const extent{100.0, 100.0, 1e-6};
+    auto const grid = eap::mesh::internal::BinZones(zones, 3, lo, extent, local_index_t(1) << 30);
+
+    std::int64_t const num_bins =
+        std::int64_t(grid.num_bins[0]) * grid.num_bins[1] * grid.num_bins[2];
+    ASSERT_LE(num_bins, std::int64_t(1) << 15);
+    ASSERT_GT(grid.num_bins[0], 1);
+    ASSERT_GT(grid.num_bins[1], 1);
+    ASSERT_EQ(num_bins + 1, std::int64_t(grid.bin_offset.extent(0)));
+
+    // The zone is listed in the bins of points inside it, and only near them
+    auto const listed = [&grid](Coordinates<double> const &point) {
+        auto const b = grid.Bin(point);
+        return grid.bin_offset(b + 1) > grid.bin_offset(b);
+    };
+
+    ASSERT_TRUE(listed({15.0, 35.0, 0.0}));
+    ASSERT_TRUE(listed({10.5, 39.5, 1e-6}));
+    ASSERT_FALSE(listed({50.0, 35.0, 0.0}));
+    ASSERT_FALSE(listed({15.0, 80.0, 0.0}));
+}
@@ -7,6 +7,9 @@
  * @copyright Copyright (C) 2019 Triad National Security, LLC
  */
 
+// STL Includes
+#include <vector>
+
 // Third Party Includes
 #include <gtest/gtest.h>
 
@@ -28,7 +31,8 @@ void ImplLevelsBasicTest() {
         KidMomOptions{
             false, // kid_mom_use_s2s
             false, // mom_kid_use_s2s
-            false  // mom_kids_use_s2s
+            false, // mom_kids_use_s2s
+            false  // level_major_renumbering
         }          // kid_mom
     };
 
@@ -77,9 +81,11 @@ void ImplLevelsBasicTest() {
         // Test FilterAtLevel
         Kokkos::View<local_index_t *> cells_at_level_over_1("cells_at_level_over_1",
                                                             num_at_level_over_1);
-        levs.FilterAtLevel(
+        auto const num_filtered = levs.FilterAtLevel(
             0, 0, cells_at_level_over_1, KOKKOS_LAMBDA(local_index_t const lp) { return lp >= 1; });
 
+        ASSERT_EQ(num_at_level_over_1, num_filtered);
+
         for (local_index_t i = 0; i < num_local_cells - 1; i++) {
             ASSERT_EQ(i + 1, cells_at_level_over_1(i));
         }
@@ -272,7 +278,451 @@ void ImplLevelsBasicTest() {
                 ASSERT_EQ(nullint, levs.cell_level.view_host()(i));
             }
         }
+
+        // Re-packing should only keep the remaining cells, in cell order
+        levs.BuildPack(cells);
+
+        ASSERT_EQ(num_local_cells / 2, levs.NumAtLevel(0));
+
+        local_index_t i = 0;
+        levs.ForEachAtLevelSerial(0, [&i](local_index_t const l) {
+            ASSERT_EQ(2 * i, l);
+            i++;
+        });
+        ASSERT_EQ(num_local_cells / 2, i);
     }
 }
 
-TEST(Levels, Basic) { ImplLevelsBasicTest(); }
\ No newline at end of file
+TEST(Levels, Basic) { ImplLevelsBasicTest(); }
+
+void ImplLevelsSumNumTopTest() {
+    constexpr LevelOptions lev_opts{
+        3,               // num_dim
+        {1.0, 1.0, 1.0}, // cell_size
+        KidMomOptions{
+            false, // kid_mom_use_s2s
+            false, // mom_kid_use_s2s
+            false, // mom_kids_use_s2s
+            false  // level_major_renumbering
+        }          // kid_mom
+    };
+
+    auto const world = mpi::Comm::world();
+    // Differs between ranks, so a reduction that returned the local count would be caught
+    local_index_t const num_local_cells = 1000 + 100 * world.rank();
+
+    auto builder = TokenBuilder::FromComm(world);
+
+    Levels levs;
+    levs.Initialize(lev_opts);
+    levs.ResizeLocal(num_local_cells, num_local_cells);
+    levs.InitializeLevel1();
+
+    Cells cells(builder);
+    cells.ResizeCellArrays(num_local_cells, 3);
+    cells.SetNumLocalCells(num_local_cells);
+    cells.UpdateGlobalBase();
+
+    // Every cell without a daughter is a top cell if it's active
+    local_index_t num_top = 0;
+    for (local_index_t l = 0; l < num_local_cells; l++) {
+        cells.cell_active()(l) = l % 3 != 0;
+        num_top += l % 3 != 0 ? 1 : 0;
+    }
+
+    levs.BuildTop(cells);
+
+    // Local work overlapping the reduction
+    levs.BuildPack(cells);
+    ASSERT_EQ(num_local_cells, levs.NumAtLevel(0));
+
+    auto const expected = world.all_reduce(mpi::sum(), static_cast<global_index_t>(num_top));
+    ASSERT_EQ(expected, levs.SumNumTop());
+
+    // Completed reductions aren't waited on again
+    ASSERT_EQ(expected, levs.SumNumTop());
+
+    // A reduction that is never waited on is completed by the next BuildTop, or on destruction
+    {
+        Levels abandoned;
+        abandoned.Initialize(lev_opts);
+        abandoned.ResizeLocal(num_local_cells, num_local_cells);
+        abandoned.InitializeLevel1();
+
+        abandoned.BuildTop(cells);
+        abandoned.BuildTop(cells);
+    }
+
+    // Every rank completed both reductions, so later collectives still line up
+    ASSERT_EQ(expected, world.all_reduce(mpi::sum(), static_cast<global_index_t>(num_top)));
+}
+
+TEST(Levels, SumNumTop) { ImplLevelsSumNumTopTest(); }
+
+void ImplLevelsChunkIdsTest() {
+    constexpr LevelOptions lev_opts{
+        3,               // num_dim
+        {1.0, 1.0, 1.0}, // cell_size
+        KidMomOptions{
+            false, // kid_mom_use_s2s
+            false, // mom_kid_use_s2s
+            false, // mom_kids_use_s2s
+            false  // level_major_renumbering
+        }          // kid_mom
+    };
+
+    constexpr local_index_t num_local_cells = 1000;
+    constexpr local_index_t num_clone_cells = 2 * ELEM_MAX + 5;
+    constexpr local_index_t num_cells_with_clones = num_local_cells + num_clone_cells;
+
+    auto builder = TokenBuilder::FromComm(mpi::Comm::world());
+
+    Levels levs;
+    levs.Initialize(lev_opts);
+    levs.ResizeLocal(num_local_cells, num_cells_with_clones);
+    levs.InitializeLevel1();
+
+    Cells cells(builder);
+    cells.ResizeCellArrays(num_cells_with_clones, 3);
+    cells.SetNumLocalCells(num_local_cells);
+    cells.UpdateGlobalBase();
+    cells.num_local_cells_with_clones() = num_cells_with_clones;
+
+    // Runs of top cells both shorter and longer than ELEM_MAX, split by inactive cells
+    auto const is_top = [](local_index_t const l) { return l % 50 != 7 && l % 77 != 0; };
+    for (local_index_t l = 0; l < num_local_cells; l++) {
+        cells.cell_active()(l) = is_top(l);
+    }
+
+    levs.BuildTop(cells);
+    levs.SetupAllTop(cells);
+
+    // Serial reference: a new chunk starts at each gap between top cells, and every ELEM_MAX
+    // cells within a run, followed by the clone cells in chunks of ELEM_MAX
+    std::vector<local_index_t> expected(num_cells_with_clones, -1);
+    local_index_t chunk = -1;
+    local_index_t run_length = 0;
+    for (local_index_t l = 0; l < num_local_cells; l++) {
+        if (!is_top(l)) {
+            run_length = 0;
+            continue;
+        }
+
+        if (run_length % ELEM_MAX == 0) {
+            chunk++;
+        }
+        run_length++;
+        expected[l] = chunk;
+    }
+    for (local_index_t l = num_local_cells; l < num_cells_with_clones; l++) {
+        if ((l - num_local_cells) % ELEM_MAX == 0) {
+            chunk++;
+        }
+        expected[l] = chunk;
+    }
+
+    ASSERT_EQ(chunk + 1, levs.ChunkCount());
+
+    auto const chunk_ids = levs.ChunkIds();
+    for (local_index_t l = 0; l < num_cells_with_clones; l++) {
+        if (expected[l] >= 0) {
+            ASSERT_EQ(expected[l], local_index_t(chunk_ids(l))) << "cell " << l;
+        }
+    }
+}
+
+TEST(Levels, ChunkIds) { ImplLevelsChunkIdsTest(); }
+
+void ImplLevelsRenumberingTest() {
+    constexpr LevelOptions lev_opts{
+        3,               // num_dim
+        {1.0, 1.0, 1.0}, // cell_size
+        KidMomOptions{
+            false, // kid_mom_use_s2s
+            false, // mom_kid_use_s2s
+            false, // mom_kids_use_s2s
+            true   // level_major_renumbering
+        }          // kid_mom
+    };
+
+    constexpr local_index_t num_local_cells = 1000;
+    constexpr local_index_t num_levels = 3;
+    constexpr local_index_t no_level = num_levels;
+
+    auto builder = TokenBuilder::FromComm(mpi::Comm::world());
+
+    Levels levs;
+    levs.Initialize(lev_opts);
+    levs.ResizeLocal(num_local_cells, num_local_cells);
+    levs.InitializeLevel1();
+
+    Cells cells(builder);
+    cells.ResizeCellArrays(num_local_cells, 3);
+    cells.SetNumLocalCells(num_local_cells);
+    cells.UpdateGlobalBase();
+
+    // Interleaves the levels, and clears some level 0 cells, which are renumbered last
+    auto const level_of = [](local_index_t const l) {
+        return l % 3 == 0 && l % 10 == 0 ? no_level : l % 3;
+    };
+    for (local_index_t l = 0; l < num_local_cells; l++) {
+        if (l % 3 != 0) {
+            levs.ReconDivChild(cells, l % 3 - 1, 0, l);
+        }
+    }
+
+    levs.BuildPack(cells);
+
+    {
+        Kokkos::View<bool *, eap::HostMemorySpace> flags("flags", num_local_cells);
+        for (local_index_t l = 0; l < num_local_cells; l++) {
+            flags(l) = level_of(l) != no_level;
+        }
+        levs.ClearAtLevel(0, flags);
+    }
+
+    levs.BuildPack(cells);
+
+    // The two maps are inverse permutations
+    auto const new_to_old = levs.RenumberNewToOld();
+    auto const old_to_new = levs.RenumberOldToNew();
+    ASSERT_EQ(num_local_cells, local_index_t(new_to_old.extent(0)));
+    ASSERT_EQ(num_local_cells, local_index_t(old_to_new.extent(0)));
+
+    std::vector<bool> seen(num_local_cells, false);
+    for (local_index_t i = 0; i < num_local_cells; i++) {
+        local_index_t const old = local_index_t(new_to_old(i));
+        ASSERT_TRUE(old >= 0 && old < num_local_cells);
+        ASSERT_FALSE(seen[old]);
+        seen[old] = true;
+        ASSERT_EQ(i, local_index_t(old_to_new(old)));
+    }
+
+    // Renumbering makes each level contiguous, keeps cells in order within a level, and places
+    // the cells without a level last
+    Kokkos::View<local_index_t *, eap::HostMemorySpace> data_1d("data_1d", num_local_cells);
+    Kokkos::View<local_index_t **, eap::HostMemorySpace> data_2d("data_2d", num_local_cells, 2);
+    for (local_index_t l = 0; l < num_local_cells; l++) {
+        data_1d(l) = l;
+        data_2d(l, 0) = level_of(l);
+        data_2d(l, 1) = l;
+    }
+
+    levs.ApplyRenumbering(data_1d);
+    levs.ApplyRenumbering(data_2d);
+
+    for (local_index_t i = 0; i < num_local_cells; i++) {
+        ASSERT_EQ(local_index_t(new_to_old(i)), data_1d(i));
+        ASSERT_EQ(data_1d(i), data_2d(i, 1));
+        ASSERT_EQ(level_of(data_1d(i)), data_2d(i, 0));
+
+        if (i > 0) {
+            ASSERT_LE(data_2d(i - 1, 0), data_2d(i, 0));
+            if (data_2d(i - 1, 0) == data_2d(i, 0)) {
+                ASSERT_LT(data_1d(i - 1), data_1d(i));
+            }
+        }
+    }
+}
+
+TEST(Levels, Renumbering) { ImplLevelsRenumberingTest(); }
+
+/**
+ * @brief Checks that the per-level loops visit exactly the cells in CellsAtLevel, whether they
+ * iterate runs of consecutive cells or the cell list
+ */
+void CheckAtLevelMatchesCellList(Levels const &levs,
+                                 local_index_t num_cells,
+                                 local_index_t num_levels) {
+    using HostExecSpace = Kokkos::DefaultHostExecutionSpace;
+
+    for (local_index_t level = 0; level < num_levels; level++) {
+        auto const cells_at_level = levs.CellsAtLevel(level).view_host();
+
+        // One extra entry catches a loop that runs past the last cell
+        std::vector<int> expected(num_cells + 1, 0);
+        local_index_t expected_even = 0;
+        for (size_t i = 0; i < cells_at_level.extent(0); i++) {
+            local_index_t const l = cells_at_level(i);
+            expected[l]++;
+            expected_even += l % 2 == 0 ? 1 : 0;
+        }
+
+        Kokkos::View<int *, eap::HostMemorySpace> visits("visits", num_cells + 1);
+        levs.ParallelForEachAtLevel<HostExecSpace>(
+            level, KOKKOS_LAMBDA(local_index_t const l) { Kokkos::atomic_increment(&visits(l)); });
+
+        std::vector<int> serial_visits(num_cells + 1, 0);
+        levs.ForEachAtLevelSerial(level, [&](local_index_t const l) { serial_visits[l]++; });
+
+        for (local_index_t l = 0; l <= num_cells; l++) {
+            ASSERT_EQ(expected[l], visits(l)) << "level " << level << ", cell " << l;
+            ASSERT_EQ(expected[l], serial_visits[l]) << "level " << level << ", cell " << l;
+        }
+
+        auto const num_even = levs.CountFilterAtLevel<HostExecSpace>(
+            level, num_cells, KOKKOS_LAMBDA(local_index_t const l) { return l % 2 == 0; });
+        ASSERT_EQ(expected_even, num_even) << "level " << level;
+    }
+}
+
+void ImplLevelsSegmentsTest() {
+    constexpr LevelOptions lev_opts{
+        3,               // num_dim
+        {1.0, 1.0, 1.0}, // cell_size
+        KidMomOptions{
+            false, // kid_mom_use_s2s
+            false, // mom_kid_use_s2s
+            false, // mom_kids_use_s2s
+            false  // level_major_renumbering
+        }          // kid_mom
+    };
+
+    constexpr local_index_t num_local_cells = 1000;
+    constexpr local_index_t num_levels = 3;
+
+    auto const world = mpi::Comm::world();
+    auto builder = TokenBuilder::FromComm(world);
+
+    Cells cells(builder);
+    cells.ResizeCellArrays(num_local_cells, 3);
+    cells.SetNumLocalCells(num_local_cells);
+    cells.UpdateGlobalBase();
+
+    // Interleaved levels, so each level is many runs of one cell
+    {
+        Levels levs;
+        levs.Initialize(lev_opts);
+        levs.ResizeLocal(num_local_cells, num_local_cells);
+        levs.InitializeLevel1();
+
+        for (local_index_t l = 0; l < num_local_cells; l++) {
+            if (l % 3 != 0) {
+                levs.ReconDivChild(cells, l % 3 - 1, 0, l);
+            }
+        }
+
+        levs.BuildPack(cells);
+        CheckAtLevelMatchesCellList(levs, num_local_cells, num_levels);
+    }
+
+    // Contiguous levels, as after a level-major renumbering, take the single run fast paths
+    auto const level_of = [](local_index_t const l) -> local_index_t {
+        return l < 300 ? 0 : l < 700 ? 1 : 2;
+    };
+
+    Levels levs;
+    levs.Initialize(lev_opts);
+    // One extra entry, so a loop over stale segments stays in bounds
+    levs.ResizeLocal(num_local_cells, num_local_cells + 1);
+    levs.InitializeLevel1();
+
+    for (local_index_t l = 0; l < num_local_cells; l++) {
+        if (level_of(l) > 0) {
+            levs.ReconDivChild(cells, level_of(l) - 1, 0, l);
+        }
+    }
+
+    levs.BuildPack(cells);
+    ASSERT_EQ(300, levs.NumAtLevel(0));
+    ASSERT_EQ(400, levs.NumAtLevel(1));
+    ASSERT_EQ(300, levs.NumAtLevel(2));
+    CheckAtLevelMatchesCellList(levs, num_local_cells, num_levels);
+
+    // Drops the first cell by shifting every other cell down by one
+    std::vector<FortranLocalIndex> send_start(world.size(), 0);
+    std::vector<local_index_t> send_length(world.size(), 0);
+    std::vector<FortranLocalIndex> recv_start(world.size(), 0);
+    std::vector<local_index_t> recv_length(world.size(), 0);
+    send_start[world.rank()] = 1;
+    send_length[world.rank()] = num_local_cells - 1;
+    recv_length[world.rank()] = num_local_cells - 1;
+
+    levs.ReconMove(num_local_cells, send_start, send_length, recv_start, recv_length);
+
+    // The segments no longer describe lpoint, so the loops must fall back to the cell list
+    CheckAtLevelMatchesCellList(levs, num_local_cells, num_levels);
+
+    // BuildPack rebuilds the segments for the moved levels. The last cell keeps its level.
+    levs.BuildPack(cells);
+    ASSERT_EQ(299, levs.NumAtLevel(0));
+    ASSERT_EQ(400, levs.NumAtLevel(1));
+    ASSERT_EQ(301, levs.NumAtLevel(2));
+    CheckAtLevelMatchesCellList(levs, num_local_cells, num_levels);
+
+    for (local_index_t level = 0; level < num_levels; level++) {
+        local_index_t num_visited = 0;
+        levs.ForEachAtLevelSerial(level, [&](local_index_t const l) {
+            local_index_t const moved_from = l + 1 < num_local_cells ? l + 1 : l;
+            ASSERT_EQ(level_of(moved_from), level) << "cell " << l;
+            num_visited++;
+        });
+        ASSERT_EQ(levs.NumAtLevel(level), num_visited);
+    }
+}
+
+TEST(Levels, Segments) { ImplLevelsSegmentsTest(); }
+
+void ImplLevelsLargeBuildPackTest() {
+    constexpr LevelOptions lev_opts{
+        3,               // num_dim
+        {1.0, 1.0, 1.0}, // cell_size
+        KidMomOptions{
+            false, // kid_mom_use_s2s
+            false, // mom_kid_use_s2s
+            false, // mom_kids_use_s2s
+            false  // level_major_renumbering
+        }          // kid_mom
+    };
+
+    // Enough cells for BuildPack to split the counting sort into several blocks, when the host
+    // execution space has more than one thread. Not a multiple of the block size, so the last
+    // block is short.
+    constexpr local_index_t num_local_cells = 5 * 4096 + 123;
+    constexpr local_index_t num_levels = 5;
+
+    auto builder = TokenBuilder::FromComm(mpi::Comm::world());
+
+    Cells cells(builder);
+    cells.ResizeCellArrays(num_local_cells, 3);
+    cells.SetNumLocalCells(num_local_cells);
+    cells.UpdateGlobalBase();
+
+    Levels levs;
+    levs.Initialize(lev_opts);
+    levs.ResizeLocal(num_local_cells, num_local_cells);
+    levs.InitializeLevel1();
+
+    // Scatters the levels so that every block holds cells of every level
+    auto const level_of = [](local_index_t const l) -> local_index_t {
+        return (l * 7919 + l / 613) % num_levels;
+    };
+    for (local_index_t l = 0; l < num_local_cells; l++) {
+        if (level_of(l) > 0) {
+            levs.ReconDivChild(cells, level_of(l) - 1, 0, l);
+        }
+    }
+
+    levs.BuildPack(cells);
+
+    // A serial stable sort on level: each level in order of cell index
+    std::vector<std::vector<local_index_t>> expected(num_levels);
+    for (local_index_t l = 0; l < num_local_cells; l++) {
+        expected[level_of(l)].push_back(l);
+    }
+
+    for (local_index_t level = 0; level < num_levels; level++) {
+        auto const cells_at_level = levs.CellsAtLevel(level).view_host();
+
+        ASSERT_EQ(local_index_t(expected[level].size()), levs.NumAtLevel(level));
+        ASSERT_EQ(expected[level].size(), cells_at_level.extent(0));
+        for (size_t i = 0; i < expected[level].size(); i++) {
+            ASSERT_EQ(expected[level][i], local_index_t(cells_at_level(i)))
+                << "level " << level << ", position " << i;
+        }
+    }
+
+    CheckAtLevelMatchesCellList(levs, num_local_cells, num_levels);
+}
+
+TEST(Levels, LargeBuildPack) { ImplLevelsLargeBuildPackTest(); }
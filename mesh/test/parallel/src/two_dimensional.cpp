@@ -3,11 +3,67 @@
 
 using namespace eap::mesh;
 
-// TEST(TwoDimensional, Basic) {
-//     auto world = mpi::Comm::world();
-//     auto mesh = Mesh::from_global_2d_dimensions(&world, 10, 10);
-
-//     ASSERT_EQ(10, mesh.extent_0());
-//     ASSERT_EQ(10, mesh.extent_1());
-//     ASSERT_EQ(0, mesh.extent_2());
-// }
\ No newline at end of file
+TEST(TwoDimensional, Basic) {
+    auto world = mpi::Comm::world();
+    auto mesh = Mesh::from_global_2d_dimensions(&world, 10, 10);
+
+    auto const &base = mesh.global_base_address();
+    auto const rank = static_cast<size_t>(world.rank());
+
+    ASSERT_EQ(static_cast<size_t>(world.size()) + 1, base.size());
+    ASSERT_EQ(100u, base.back());
+    ASSERT_EQ(base[rank + 1] - base[rank], mesh.num_local_cells());
+    ASSERT_EQ(base[rank], mesh.global_base());
+
+    // Every cell lies within the global extents and the local bounding box
+    auto const lo = mesh.local_lo();
+    auto const cell_coordinates = mesh.cell_coordinates();
+    for (local_index_t l = 0; l < mesh.num_local_cells(); l++) {
+        ASSERT_LT(cell_coordinates(l, 0), 10u);
+        ASSERT_LT(cell_coordinates(l, 1), 10u);
+        ASSERT_EQ(0u, cell_coordinates(l, 2));
+
+        ASSERT_GE(cell_coordinates(l, 0), lo[0]);
+        ASSERT_LT(cell_coordinates(l, 0), lo[0] + mesh.local_extent_0());
+        ASSERT_GE(cell_coordinates(l, 1), lo[1]);
+        ASSERT_LT(cell_coordinates(l, 1), lo[1] + mesh.local_extent_1());
+    }
+
+    if (mesh.num_local_cells() > 0) {
+        ASSERT_EQ(1u, mesh.local_extent_2());
+    }
+}
+
+TEST(TwoDimensional, RankWeights) {
+    auto world = mpi::Comm::world();
+    auto builder = MeshBuilder::from_comm(&world);
+    builder.set_global_extents(64, 32);
+    builder.set_block_layout_method(BlockLayoutMethod::Hilbert);
+
+    std::vector<double> weights(world.size());
+    for (size_t rank = 0; rank < weights.size(); rank++) {
+        weights[rank] = rank + 1.0;
+    }
+    auto const total_weight = weights.size() * (weights.size() + 1) / 2.0;
+    builder.set_rank_weights(std::move(weights));
+
+    auto const num_global_blocks = builder.num_global_blocks();
+    auto const mesh = builder.build();
+
+    // Each rank gets its share of the blocks, to within rounding
+    auto const &base = mesh.global_base_address();
+    for (size_t rank = 0; rank + 1 < base.size(); rank++) {
+        auto const num_blocks = (base[rank + 1] - base[rank]) / builder.block_size();
+        auto const expected = num_global_blocks * (rank + 1.0) / total_weight;
+        ASSERT_NEAR(expected, num_blocks, 1.0) << "rank = " << rank;
+    }
+
+    // Each cell appears once across the local block range
+    std::vector<bool> seen(64 * 32, false);
+    auto const cell_coordinates = mesh.cell_coordinates();
+    for (local_index_t l = 0; l < mesh.num_local_cells(); l++) {
+        auto const linear = cell_coordinates(l, 0) + 64 * cell_coordinates(l, 1);
+        ASSERT_FALSE(seen[linear]) << "l = " << l;
+        seen[linear] = true;
+    }
+}
@@ -1,6 +1,9 @@
+#include <algorithm>
 #include <array>
+#include <vector>
 #include <gtest/gtest.h>
 #include <mesh-blocks.hpp>
+#include <mesh-blocks_compute.hpp>
 
 using namespace eap;
 
@@ -157,4 +160,141 @@ TEST(Blocks, ThreeDimensionalReverse) {
     mesh::BlockLayout layout{mesh::BlockLayoutMethod::ColumnMajorReverse, X, Y, Z};
 
     check_layout(layout, expected);
-}
\ No newline at end of file
+}
+
+TEST(Blocks, TwoDimensionalHilbert) {
+    constexpr auto N = 2;
+
+    std::array<mesh::BlockCoordinates, N * N> expected{
+        BC{0, 0},
+        BC{0, 1},
+        BC{1, 1},
+        BC{1, 0},
+    };
+
+    mesh::BlockLayout layout{mesh::BlockLayoutMethod::Hilbert, N, N};
+
+    check_layout(layout, expected);
+}
+
+TEST(Blocks, TwoDimensionalMorton) {
+    constexpr auto N = 2;
+
+    std::array<mesh::BlockCoordinates, N * N> expected{
+        BC{0, 0},
+        BC{0, 1},
+        BC{1, 0},
+        BC{1, 1},
+    };
+
+    mesh::BlockLayout layout{mesh::BlockLayoutMethod::Morton, N, N};
+
+    check_layout(layout, expected);
+}
+
+TEST(Blocks, HilbertIsContinuous) {
+    // On power-of-two extents, each block along the curve is a face neighbor of the last
+    for (auto const &extents : {std::array<global_index_t, 3>{8, 8, 1},
+                                std::array<global_index_t, 3>{16, 1, 16},
+                                std::array<global_index_t, 3>{4, 4, 4}}) {
+        mesh::BlockLayout layout{
+            mesh::BlockLayoutMethod::Hilbert, extents[0], extents[1], extents[2]};
+
+        for (global_index_t a = 1; a < layout.size(); a++) {
+            auto const prev = layout.GetCoordinates(a - 1);
+            auto const next = layout.GetCoordinates(a);
+
+            auto const distance = std::max(prev.x, next.x) - std::min(prev.x, next.x) +
+                                  std::max(prev.y, next.y) - std::min(prev.y, next.y) +
+                                  std::max(prev.z, next.z) - std::min(prev.z, next.z);
+            ASSERT_EQ(1u, distance);
+        }
+    }
+}
+
+TEST(Blocks, CurvesNonPowerOfTwo) {
+    // Curves over any extents visit every block exactly once
+    for (auto const method : {mesh::BlockLayoutMethod::Hilbert, mesh::BlockLayoutMethod::Morton}) {
+        mesh::BlockLayout layout{method, 5, 3, 7};
+
+        std::vector<bool> visited(layout.size(), false);
+        for (global_index_t a = 0; a < layout.size(); a++) {
+            auto const coords = layout.GetCoordinates(a);
+            ASSERT_LT(coords.x, 5u);
+            ASSERT_LT(coords.y, 3u);
+            ASSERT_LT(coords.z, 7u);
+
+            auto const linear = coords.x + 5 * (coords.y + 3 * coords.z);
+            ASSERT_FALSE(visited[linear]);
+            visited[linear] = true;
+
+            ASSERT_EQ(a, layout.GetAddress(coords));
+        }
+    }
+}
+
+TEST(Blocks, CurvesLarge) {
+    // Curve layouts store nothing per block, so they can address far more blocks than fit in memory
+    for (auto const method : {mesh::BlockLayoutMethod::Hilbert, mesh::BlockLayoutMethod::Morton}) {
+        mesh::BlockLayout layout{method, 1000003, 999983, 1000};
+
+        for (auto const a : {global_index_t(0),
+                             layout.size() / 3,
+                             layout.size() / 2,
+                             layout.size() - 2,
+                             layout.size() - 1}) {
+            auto const coords = layout.GetCoordinates(a);
+            ASSERT_LT(coords.x, 1000003u);
+            ASSERT_LT(coords.y, 999983u);
+            ASSERT_LT(coords.z, 1000u);
+
+            ASSERT_EQ(a, layout.GetAddress(coords));
+        }
+    }
+}
+
+TEST(Blocks, Bulk) {
+    // The bulk conversions agree with the per-block ones for every method
+    for (auto const method : {mesh::BlockLayoutMethod::ColumnMajor,
+                              mesh::BlockLayoutMethod::Hilbert,
+                              mesh::BlockLayoutMethod::ColumnMajorZigZag,
+                              mesh::BlockLayoutMethod::ColumnMajorReverse,
+                              mesh::BlockLayoutMethod::Morton}) {
+        mesh::BlockLayout layout{method, 5, 3, 7};
+
+        Kokkos::View<global_index_t *, HostMemorySpace> addresses("addresses", layout.size());
+        for (global_index_t a = 0; a < layout.size(); a++) {
+            addresses(a) = a;
+        }
+
+        Kokkos::View<global_index_t **, Kokkos::LayoutLeft, HostMemorySpace> coordinates(
+            "coordinates", layout.size(), 3);
+        mesh::GetBlockCoordinates(layout, addresses, coordinates);
+
+        for (global_index_t a = 0; a < layout.size(); a++) {
+            ASSERT_EQ(layout.GetCoordinates(a),
+                      (BC{coordinates(a, 0), coordinates(a, 1), coordinates(a, 2)}));
+        }
+
+        Kokkos::View<global_index_t *, HostMemorySpace> round_trip("round_trip", layout.size());
+        mesh::GetBlockAddresses(layout, coordinates, round_trip);
+
+        for (global_index_t a = 0; a < layout.size(); a++) {
+            ASSERT_EQ(a, round_trip(a));
+        }
+    }
+
+    mesh::BlockLayout layout{mesh::BlockLayoutMethod::ColumnMajor, 2, 2};
+
+    Kokkos::View<global_index_t *, HostMemorySpace> addresses("addresses", 1);
+    Kokkos::View<global_index_t **, Kokkos::LayoutLeft, HostMemorySpace> coordinates(
+        "coordinates", 1, 3);
+
+    addresses(0) = 4;
+    ASSERT_THROW(mesh::GetBlockCoordinates(layout, addresses, coordinates),
+                 mesh::InvalidBlockAddressError);
+
+    coordinates(0, 1) = 2;
+    ASSERT_THROW(mesh::GetBlockAddresses(layout, coordinates, addresses),
+                 mesh::InvalidBlockCoordinatesError);
+}
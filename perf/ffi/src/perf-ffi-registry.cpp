@@ -2,9 +2,12 @@
 
 #include <algorithm>
 #include <chrono>
+#include <fstream>
 #include <nonstd/optional.hpp>
+#include <perf-chrome_trace.hpp>
 #include <perf-ffi-interop.hpp>
 #include <perf-registry.hpp>
+#include <string>
 
 using eap::perf::ffi::DurationToFFI;
 using eap::perf::ffi::TimerHandleFromFFI;
@@ -102,6 +105,65 @@ void eap_perf_timer_registry_get_statistics(eap_perf_timer_registry_t const *reg
     timer_stats->min_time = DurationToFFI(timer.MinTime());
 }
 
+EXTERN_C
+void eap_perf_timer_registry_enable_histograms(eap_perf_timer_registry_t *registry) {
+    TimerRegistryFromFFI(registry)->EnableHistograms();
+}
+
+EXTERN_C
+void eap_perf_timer_registry_get_percentiles(eap_perf_timer_registry_t const *registry,
+                                             eap_perf_timer_handle_t timer_handle,
+                                             eap_perf_timer_percentiles_t *timer_percentiles) {
+    auto const &timer = TimerRegistryFromFFI(registry)->GetTimer(TimerHandleFromFFI(timer_handle));
+
+    timer_percentiles->p50 = DurationToFFI(timer.Percentile(50.0));
+    timer_percentiles->p90 = DurationToFFI(timer.Percentile(90.0));
+    timer_percentiles->p99 = DurationToFFI(timer.Percentile(99.0));
+    timer_percentiles->p999 = DurationToFFI(timer.Percentile(99.9));
+}
+
+EXTERN_C
+void eap_perf_timer_registry_get_percentile(eap_perf_timer_registry_t const *registry,
+                                            eap_perf_timer_handle_t timer_handle,
+                                            double percentile,
+                                            int64_t *time) {
+    auto const &timer = TimerRegistryFromFFI(registry)->GetTimer(TimerHandleFromFFI(timer_handle));
+    *time = DurationToFFI(timer.Percentile(percentile));
+}
+
+EXTERN_C
+void eap_perf_timer_registry_enable_counters(eap_perf_timer_registry_t *registry, bool *available) {
+    *available = TimerRegistryFromFFI(registry)->EnableCounters();
+}
+
+EXTERN_C
+void eap_perf_timer_registry_get_counters(eap_perf_timer_registry_t const *registry,
+                                          eap_perf_timer_handle_t timer_handle,
+                                          eap_perf_timer_counters_t *timer_counters) {
+    using eap::perf::HardwareEvent;
+
+    auto const &timer = TimerRegistryFromFFI(registry)->GetTimer(TimerHandleFromFFI(timer_handle));
+
+    // Without counters, every event is reported as not counted
+    eap::perf::HardwareCounters const none;
+    auto const &counters = timer.GetCounters() ? *timer.GetCounters() : none;
+
+    auto const count = [&](HardwareEvent event, std::uint64_t value) {
+        return counters.Counted(event) ? static_cast<int64_t>(value) : int64_t(-1);
+    };
+    auto const ratio = [](nonstd::optional<double> value) { return value.value_or(-1.0); };
+
+    timer_counters->runs = timer.GetCounters() ? static_cast<int64_t>(counters.runs) : -1;
+    timer_counters->cycles = count(HardwareEvent::Cycles, counters.cycles);
+    timer_counters->instructions = count(HardwareEvent::Instructions, counters.instructions);
+    timer_counters->llc_misses = count(HardwareEvent::LlcMisses, counters.llc_misses);
+    timer_counters->branch_misses = count(HardwareEvent::BranchMisses, counters.branch_misses);
+    timer_counters->ipc = ratio(counters.Ipc());
+    timer_counters->llc_misses_per_kilo_instruction = ratio(counters.LlcMissesPerKiloInstruction());
+    timer_counters->branch_misses_per_kilo_instruction =
+        ratio(counters.BranchMissesPerKiloInstruction());
+}
+
 EXTERN_C
 void eap_perf_timer_registry_get_num_timers(eap_perf_timer_registry_t const *registry,
                                             size_t *num_timers) {
@@ -129,4 +191,56 @@ bool eap_perf_timer_registry_next_timer(eap_perf_timer_registry_t const *registr
 
     *timer_handle += 1;
     return *timer_handle < (eap_perf_timer_handle_t)timer_registry.Count();
+}
+
+EXTERN_C
+void eap_perf_timer_registry_set_call_tree_mode(eap_perf_timer_registry_t *registry, bool enable) {
+    TimerRegistryFromFFI(registry)->SetTimingMode(enable ? eap::perf::TimingMode::CallTree
+                                                         : eap::perf::TimingMode::Outermost);
+}
+
+EXTERN_C
+void eap_perf_timer_registry_get_num_call_tree_nodes(eap_perf_timer_registry_t const *registry,
+                                                     size_t *num_nodes) {
+    // The root isn't exposed
+    *num_nodes = TimerRegistryFromFFI(registry)->GetCallTree().Count() - 1;
+}
+
+EXTERN_C
+void eap_perf_timer_registry_get_call_tree_node(eap_perf_timer_registry_t const *registry,
+                                                size_t index,
+                                                eap_perf_call_tree_node_t *node) {
+    auto const &tree = TimerRegistryFromFFI(registry)->GetCallTree();
+    auto const &tree_node = tree.GetNode(index + 1);
+
+    node->timer = TimerHandleToFFI(tree_node.timer);
+    node->parent = static_cast<ptrdiff_t>(tree_node.parent) - 1;
+    node->count = tree_node.count;
+    node->inclusive_time =
+        duration_cast<eap::perf::ffi::FFIDuration>(tree_node.inclusive_time).count();
+    node->exclusive_time =
+        duration_cast<eap::perf::ffi::FFIDuration>(tree_node.ExclusiveTime()).count();
+}
+
+EXTERN_C
+void eap_perf_timer_registry_enable_tracing(eap_perf_timer_registry_t *registry, size_t capacity) {
+    TimerRegistryFromFFI(registry)->EnableTracing(capacity);
+}
+
+EXTERN_C
+bool eap_perf_timer_registry_write_chrome_trace(eap_perf_timer_registry_t const *registry,
+                                                char const *path,
+                                                int pid) {
+    std::ofstream file(path);
+    eap::perf::WriteChromeTrace(file, *TimerRegistryFromFFI(registry), pid);
+    return static_cast<bool>(file);
+}
+
+EXTERN_C
+bool eap_perf_timer_registry_write_chrome_trace_f(eap_perf_timer_registry_t const *registry,
+                                                  char const *path,
+                                                  size_t path_length,
+                                                  int pid) {
+    return eap_perf_timer_registry_write_chrome_trace(
+        registry, std::string(path, path_length).c_str(), pid);
 }
\ No newline at end of file
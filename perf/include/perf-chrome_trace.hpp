@@ -0,0 +1,141 @@
+/**
+ * @brief Writes the events traced by a TimerRegistry in the Chrome trace-event JSON format, which
+ *  can be viewed with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * @file perf-chrome_trace.hpp
+ *
+ * @date 2019-09-26
+ */
+
+#ifndef EAP_PERF_CHROME_TRACE_HPP
+#define EAP_PERF_CHROME_TRACE_HPP
+
+#include "perf-registry.hpp"
+#include "perf-trace.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <nonstd/string_view.hpp>
+#include <ostream>
+#include <vector>
+
+namespace eap {
+namespace perf {
+
+namespace internal {
+/**
+ * @brief Writes `name` as a JSON string
+ */
+inline void WriteJsonString(std::ostream &os, nonstd::string_view name) {
+    os << '"';
+    for (auto const c : name) {
+        switch (c) {
+        case '"':
+            os << "\\\"";
+            break;
+        case '\\':
+            os << "\\\\";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                os << escaped;
+            } else {
+                os << c;
+            }
+        }
+    }
+    os << '"';
+}
+
+/**
+ * @brief Writes `nanoseconds` in microseconds, the unit of the trace-event format, without
+ *  rounding.
+ */
+inline void WriteMicroseconds(std::ostream &os, std::int64_t nanoseconds) {
+    char formatted[32];
+    std::snprintf(formatted,
+                  sizeof(formatted),
+                  "%lld.%03lld",
+                  static_cast<long long>(nanoseconds / 1000),
+                  static_cast<long long>(nanoseconds % 1000));
+    os << formatted;
+}
+} // namespace internal
+
+/**
+ * @brief Writes each event traced by `registry` as a trace-event JSON object, separated by commas.
+ *
+ * @details
+ *  Writes only the events, so that events from several registries, such as one per rank, can be
+ *  combined into one file. Use WriteChromeTrace to write a complete file.
+ *
+ *  Every run is written as a complete ("X") event, with `pid` as its process and the recording
+ *  thread's ThreadIndex as its thread.
+ *
+ * @param os
+ *  Stream to write to
+ * @param registry
+ *  Registry that traced the events. See TimerRegistry::EnableTracing.
+ * @param pid
+ *  Process id shown in the viewer, typically the MPI rank
+ * @param first
+ *  Whether these are the first events written to the list, in which case no leading comma is
+ *  written.
+ * @return std::size_t
+ *  The number of events written
+ */
+template <typename Clock>
+std::size_t WriteChromeTraceEvents(std::ostream &os,
+                                   TimerRegistry<Clock> const &registry,
+                                   int pid,
+                                   bool first = true) {
+    std::size_t num_written = 0;
+
+    // Events refer to timers by index, in registration order
+    std::vector<nonstd::string_view> names;
+    names.reserve(registry.Count());
+    for (auto const handle : registry.Timers()) {
+        names.push_back(registry.GetTimerName(handle));
+    }
+
+    registry.GetTrace().ForEach([&](TraceEvent const &event) {
+        if (!first || num_written > 0) {
+            os << ",\n";
+        }
+
+        os << "{\"name\":";
+        internal::WriteJsonString(os, names[event.timer]);
+        os << ",\"ph\":\"X\",\"ts\":";
+        internal::WriteMicroseconds(os, event.begin);
+        os << ",\"dur\":";
+        internal::WriteMicroseconds(os, event.end - event.begin);
+        os << ",\"pid\":" << pid << ",\"tid\":" << event.thread << '}';
+
+        num_written++;
+    });
+
+    return num_written;
+}
+
+/**
+ * @brief Writes the events traced by `registry` as a complete trace-event JSON document.
+ *
+ * @details
+ *  See WriteChromeTraceEvents. The number of events lost to a full trace buffer is written to the
+ *  document's "otherData".
+ */
+template <typename Clock>
+void WriteChromeTrace(std::ostream &os, TimerRegistry<Clock> const &registry, int pid = 0) {
+    os << "{\"traceEvents\":[\n";
+    WriteChromeTraceEvents(os, registry, pid);
+    os << "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"overwritten_events\":"
+       << registry.GetTrace().NumOverwritten() << "}}\n";
+}
+
+} // namespace perf
+} // namespace eap
+
+#endif // EAP_PERF_CHROME_TRACE_HPP
@@ -10,12 +10,55 @@
 #define EAP_PERF_CLOCK_HPP
 
 #include <chrono>
+#include <cstdint>
+#include <ratio>
 
 namespace eap {
 namespace perf {
-/** @brief The default C++ Clock to use in eap-timer */
+/**
+ * @brief A TrivialClock that reads the processor's time-stamp counter (TSC) if it's invariant,
+ *  and std::chrono::steady_clock otherwise.
+ *
+ * @details
+ *  An invariant TSC ticks at a constant rate in every power state and is synchronized across
+ *  cores, so reading it costs a few nanoseconds without a system call. Its rate is calibrated
+ *  against steady_clock once, by busy-waiting a few milliseconds on the first call to now(), or at
+ *  startup when TscClock is the DefaultClock.
+ *
+ *  Time points share steady_clock's epoch, so they can be compared with steady_clock time points
+ *  converted to nanoseconds.
+ *
+ *  Falls back to steady_clock on processors other than x86-64, when the TSC isn't invariant (such
+ *  as in some virtual machines), or when the calibrated rate is implausible.
+ */
+class TscClock {
+  public:
+    using rep = std::int64_t;
+    using period = std::nano;
+    using duration = std::chrono::duration<rep, period>;
+    using time_point = std::chrono::time_point<TscClock>;
+
+    static constexpr bool is_steady = true;
+
+    static time_point now() noexcept;
+
+    /** @brief Whether now() reads the TSC, rather than falling back to steady_clock */
+    static bool UsesTsc() noexcept;
+
+    /** @brief The calibrated TSC rate in ticks per second, or 0 if the TSC isn't used */
+    static double TscFrequency() noexcept;
+};
+
+/**
+ * @brief The default C++ Clock to use in eap-timer. TscClock if eap-perf was configured with
+ *  EAP_PERF_USE_TSC_CLOCK, std::chrono::steady_clock otherwise.
+ */
+#ifdef EAP_PERF_USE_TSC_CLOCK
+using DefaultClock = TscClock;
+#else
 using DefaultClock = std::chrono::steady_clock;
+#endif
 } // namespace perf
 } // namespace eap
 
-#endif // EAP_PERF_CLOCK_HPP
\ No newline at end of file
+#endif // EAP_PERF_CLOCK_HPP
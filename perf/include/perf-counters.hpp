@@ -0,0 +1,202 @@
+/**
+ * @brief Implements hardware performance counters (cycles, instructions, cache and branch misses)
+ *  that Timer can accumulate alongside run-times.
+ *
+ * @file perf-counters.hpp
+ *
+ * @date 2019-09-30
+ */
+
+#ifndef EAP_PERF_COUNTERS_HPP
+#define EAP_PERF_COUNTERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <nonstd/optional.hpp>
+
+namespace eap {
+namespace perf {
+
+/**
+ * @brief A hardware event counted by CounterGroup
+ */
+enum class HardwareEvent : unsigned {
+    /// CPU cycles, while the thread was running
+    Cycles,
+    /// Retired instructions
+    Instructions,
+    /// Last-level cache misses
+    LlcMisses,
+    /// Mispredicted branches
+    BranchMisses
+};
+
+/// The number of HardwareEvent values
+constexpr std::size_t NUM_HARDWARE_EVENTS = 4;
+
+/**
+ * @brief Hardware event counts, either a reading of a CounterGroup or the sum over the runs of a
+ *  Timer.
+ *
+ * @details
+ *  Events that couldn't be counted, e.g. LLC misses in many virtual machines, are left out of
+ *  `events` and their counts stay 0. The derived metrics return nonstd::nullopt rather than a
+ *  misleading 0 for those.
+ */
+struct HardwareCounters {
+    /// Number of runs counted
+    std::uint64_t runs = 0;
+    /// Bit `1 << HardwareEvent` is set if that event was counted in every run
+    unsigned events = 0;
+
+    std::uint64_t cycles = 0;
+    std::uint64_t instructions = 0;
+    std::uint64_t llc_misses = 0;
+    std::uint64_t branch_misses = 0;
+
+    static constexpr unsigned Bit(HardwareEvent event) noexcept {
+        return 1u << static_cast<unsigned>(event);
+    }
+
+    /** @brief Returns whether `event` was counted */
+    bool Counted(HardwareEvent event) const noexcept { return (events & Bit(event)) != 0; }
+
+    /**
+     * @brief Adds one run, counted from the CounterGroup readings `start` to `end`
+     */
+    void AddRun(HardwareCounters const &start, HardwareCounters const &end) noexcept {
+        HardwareCounters run;
+        run.runs = 1;
+        run.events = start.events & end.events;
+        run.cycles = Delta(start.cycles, end.cycles);
+        run.instructions = Delta(start.instructions, end.instructions);
+        run.llc_misses = Delta(start.llc_misses, end.llc_misses);
+        run.branch_misses = Delta(start.branch_misses, end.branch_misses);
+        *this += run;
+    }
+
+    HardwareCounters &operator+=(HardwareCounters const &other) noexcept {
+        if (other.runs == 0) {
+            return *this;
+        }
+
+        // An event is only meaningful if it was counted in the runs of both
+        events = runs == 0 ? other.events : (events & other.events);
+        runs += other.runs;
+        cycles += other.cycles;
+        instructions += other.instructions;
+        llc_misses += other.llc_misses;
+        branch_misses += other.branch_misses;
+        return *this;
+    }
+
+    /**
+     * @brief Instructions per cycle, or nonstd::nullopt if either wasn't counted or no cycles
+     *  elapsed.
+     *
+     * @details
+     *  A low IPC together with a high LlcMissesPerKiloInstruction means the code waits on memory.
+     */
+    nonstd::optional<double> Ipc() const noexcept {
+        return Ratio(HardwareEvent::Instructions, instructions, HardwareEvent::Cycles, cycles, 1.0);
+    }
+
+    /**
+     * @brief LLC misses per 1000 instructions, or nonstd::nullopt if either wasn't counted
+     */
+    nonstd::optional<double> LlcMissesPerKiloInstruction() const noexcept {
+        return Ratio(HardwareEvent::LlcMisses,
+                     llc_misses,
+                     HardwareEvent::Instructions,
+                     instructions,
+                     1000.0);
+    }
+
+    /**
+     * @brief Branch misses per 1000 instructions, or nonstd::nullopt if either wasn't counted
+     */
+    nonstd::optional<double> BranchMissesPerKiloInstruction() const noexcept {
+        return Ratio(HardwareEvent::BranchMisses,
+                     branch_misses,
+                     HardwareEvent::Instructions,
+                     instructions,
+                     1000.0);
+    }
+
+  private:
+    /// Scaling multiplexed counts can make them step back slightly, which must not wrap around
+    static std::uint64_t Delta(std::uint64_t start, std::uint64_t end) noexcept {
+        return end > start ? end - start : 0;
+    }
+
+    nonstd::optional<double> Ratio(HardwareEvent numerator_event,
+                                   std::uint64_t numerator,
+                                   HardwareEvent denominator_event,
+                                   std::uint64_t denominator,
+                                   double scale) const noexcept {
+        if (!Counted(numerator_event) || !Counted(denominator_event) || denominator == 0) {
+            return nonstd::nullopt;
+        }
+        return scale * static_cast<double>(numerator) / static_cast<double>(denominator);
+    }
+};
+
+/**
+ * @brief The calling thread's hardware counters, opened with Linux's `perf_event_open` as a
+ *  single group, so that every event is counted over the same intervals.
+ *
+ * @details
+ *  Each thread has its own group, opened on its first call to Local(), that counts only that
+ *  thread in user space. Reading it is a single `read` system call, which is much more expensive
+ *  than reading the clock, so only enable counters for sections that run for at least a few
+ *  microseconds.
+ *
+ *  Degrades gracefully: events the processor or kernel doesn't support are left out, and if none
+ *  can be opened (not Linux, a restrictive `kernel.perf_event_paranoid`, a container without the
+ *  `perf_event_open` system call, ...), IsAvailable() is false and Read() returns no events.
+ *
+ *  If the kernel has to multiplex the counters with other users, the counts are scaled up by the
+ *  fraction of time they were counting.
+ */
+class CounterGroup {
+  public:
+    /**
+     * @brief Returns the calling thread's group, opening it on the thread's first call.
+     */
+    static CounterGroup &Local();
+
+    CounterGroup(CounterGroup const &) = delete;
+    CounterGroup &operator=(CounterGroup const &) = delete;
+    ~CounterGroup();
+
+    /** @brief Returns whether any event is counted */
+    bool IsAvailable() const noexcept { return events_ != 0; }
+
+    /** @brief Returns the HardwareCounters::Bit of each counted event */
+    unsigned Events() const noexcept { return events_; }
+
+    /**
+     * @brief Returns the counts since the group was opened, with `runs` 0. See
+     *  HardwareCounters::AddRun.
+     */
+    HardwareCounters Read() const noexcept;
+
+  private:
+    CounterGroup();
+
+    /// File descriptor of each HardwareEvent, or -1 if it isn't counted
+    int fds_[NUM_HARDWARE_EVENTS];
+    unsigned events_ = 0;
+    /// Number of opened events
+    std::size_t num_open_ = 0;
+};
+
+/**
+ * @brief Returns whether hardware counters can be read on the calling thread. See CounterGroup.
+ */
+inline bool HardwareCountersAvailable() { return CounterGroup::Local().IsAvailable(); }
+
+} // namespace perf
+} // namespace eap
+
+#endif // EAP_PERF_COUNTERS_HPP
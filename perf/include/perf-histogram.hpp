@@ -0,0 +1,162 @@
+/**
+ * @brief Implements a fixed-size, log-bucketed histogram of durations used to estimate percentiles
+ *  of Timer run-times.
+ *
+ * @file perf-histogram.hpp
+ *
+ * @date 2019-09-27
+ */
+
+#ifndef EAP_PERF_HISTOGRAM_HPP
+#define EAP_PERF_HISTOGRAM_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <nonstd/optional.hpp>
+
+namespace eap {
+namespace perf {
+
+/**
+ * @brief A histogram of durations with buckets of constant relative width, in the style of
+ *  HdrHistogram.
+ *
+ * @details
+ *  Each power of two [2^e, 2^(e+1)) of clock ticks is split into 2^SUB_BUCKET_BITS equal buckets,
+ *  and durations below 2^SUB_BUCKET_BITS ticks each have their own bucket. A bucket's width is
+ *  therefore at most 1 / 2^SUB_BUCKET_BITS of the durations it holds, which bounds the relative
+ *  error of Percentile.
+ *
+ *  The buckets are a fixed array, so Record is a few integer operations and never allocates.
+ *
+ * @tparam Duration
+ *  The std::chrono::duration type recorded
+ */
+template <typename Duration>
+class DurationHistogram {
+  public:
+    using duration = Duration;
+
+    /// log2 of the number of buckets per power of two
+    static constexpr unsigned SUB_BUCKET_BITS = 4;
+    static constexpr std::size_t SUB_BUCKETS = std::size_t(1) << SUB_BUCKET_BITS;
+    /// Enough buckets for any 64-bit tick count
+    static constexpr std::size_t NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    /**
+     * @brief Adds one run of length `time`. Negative durations are recorded as 0.
+     */
+    void Record(duration time) noexcept {
+        auto const ticks = time.count() > 0 ? static_cast<std::uint64_t>(time.count()) : 0;
+        counts_[BucketOf(ticks)]++;
+        total_count_++;
+    }
+
+    /**
+     * @brief Adds every run recorded by `other`
+     */
+    void Merge(DurationHistogram const &other) noexcept {
+        for (std::size_t i = 0; i < NUM_BUCKETS; i++) {
+            counts_[i] += other.counts_[i];
+        }
+        total_count_ += other.total_count_;
+    }
+
+    /**
+     * @brief Returns the number of recorded runs
+     */
+    std::uint64_t TotalCount() const noexcept { return total_count_; }
+
+    /**
+     * @brief Estimates the `percentile`th percentile of the recorded durations.
+     *
+     * @details
+     *  Returns the upper bound of the bucket holding the run at that rank, so the result is never
+     *  below the true percentile, and above it by at most the bucket's width.
+     *
+     * @param percentile
+     *  In [0, 100], e.g. 99.9. Values outside are clamped.
+     * @return nonstd::optional<duration>
+     *  nonstd::nullopt if no runs were recorded
+     */
+    nonstd::optional<duration> Percentile(double percentile) const noexcept {
+        if (total_count_ == 0) {
+            return nonstd::nullopt;
+        }
+
+        percentile = percentile < 0.0 ? 0.0 : (percentile > 100.0 ? 100.0 : percentile);
+
+        // The 1-based rank of the run at the percentile, at least the first run
+        auto rank = static_cast<std::uint64_t>(percentile / 100.0 * total_count_ + 0.5);
+        rank = rank < 1 ? 1 : (rank > total_count_ ? total_count_ : rank);
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < NUM_BUCKETS; i++) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                return duration(static_cast<typename duration::rep>(BucketUpperBound(i)));
+            }
+        }
+
+        return duration(static_cast<typename duration::rep>(BucketUpperBound(NUM_BUCKETS - 1)));
+    }
+
+  private:
+    static std::size_t BucketOf(std::uint64_t ticks) noexcept {
+        if (ticks < SUB_BUCKETS) {
+            return static_cast<std::size_t>(ticks);
+        }
+
+        auto const exponent = Log2(ticks);
+        auto const sub_bucket = (ticks >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+        return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS +
+               static_cast<std::size_t>(sub_bucket);
+    }
+
+    /// Largest tick count that falls into `bucket`
+    static std::uint64_t BucketUpperBound(std::size_t bucket) noexcept {
+        if (bucket < SUB_BUCKETS) {
+            return bucket;
+        }
+
+        auto const exponent = bucket / SUB_BUCKETS + SUB_BUCKET_BITS - 1;
+        auto const sub_bucket = bucket % SUB_BUCKETS;
+        auto const width = std::uint64_t(1) << (exponent - SUB_BUCKET_BITS);
+        auto const lower = (std::uint64_t(1) << exponent) + sub_bucket * width;
+
+        // Keep the result representable as a signed tick count
+        auto const upper = lower + (width - 1);
+        auto const max_ticks =
+            static_cast<std::uint64_t>(std::numeric_limits<typename duration::rep>::max());
+        return upper < max_ticks ? upper : max_ticks;
+    }
+
+    static unsigned Log2(std::uint64_t value) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned log2 = 0;
+        while (value >>= 1) {
+            log2++;
+        }
+        return log2;
+#endif
+    }
+
+    std::array<std::uint64_t, NUM_BUCKETS> counts_{};
+    std::uint64_t total_count_ = 0;
+};
+
+template <typename Duration>
+constexpr unsigned DurationHistogram<Duration>::SUB_BUCKET_BITS;
+template <typename Duration>
+constexpr std::size_t DurationHistogram<Duration>::SUB_BUCKETS;
+template <typename Duration>
+constexpr std::size_t DurationHistogram<Duration>::NUM_BUCKETS;
+
+} // namespace perf
+} // namespace eap
+
+#endif // EAP_PERF_HISTOGRAM_HPP
@@ -14,13 +14,24 @@
 #include "perf-internal-sys.hpp"
 
 #include "perf-clock.hpp"
+#include "perf-counters.hpp"
 #include "perf-error.hpp"
 #include "perf-timer.hpp"
-
+#include "perf-trace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <nonstd/string_view.hpp>
 #include <stack>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace eap {
@@ -35,6 +46,8 @@ namespace perf {
 class TimerHandle {
     template <typename Clock>
     friend class TimerRegistry;
+    template <typename Clock>
+    friend class CallTree;
     friend class TimerRegistryIterator;
 
   public:
@@ -127,12 +140,198 @@ class TimerRegistryRange {
     std::size_t size_;
 };
 
+/**
+ * @brief A single (parent path, timer) pair in a CallTree.
+ *
+ * @tparam Duration
+ *  The duration type of the Clock used by the CallTree
+ */
+template <typename Duration>
+struct CallTreeNode {
+    /// The timer that was run. Meaningless for the root node.
+    TimerHandle timer;
+
+    /// Index of the parent node. The root node is its own parent.
+    std::size_t parent;
+
+    /// Index of each child node, in the order the children were first run
+    std::vector<std::size_t> children;
+
+    /// Number of times the timer was run at this point in the tree
+    std::size_t count = 0;
+
+    /// Total time spent in the timer at this point in the tree, including children
+    Duration inclusive_time{0};
+
+    /// Total time spent in the children of this node
+    Duration children_time{0};
+
+    /** @brief Returns the time spent in this node, excluding its children */
+    Duration ExclusiveTime() const { return inclusive_time - children_time; }
+};
+
+/**
+ * @brief Accumulates inclusive and exclusive time for every distinct path of nested timers.
+ *
+ * @details
+ *  Node 0 is a root that isn't associated with any timer. Every other node is the child of the
+ *  node that was on top of the timer stack when it was pushed, so the same timer run from two
+ *  different callers gets two nodes. Parents are always stored before their children.
+ *
+ * @tparam Clock
+ *  The C++ STL [TrivialClock](https://en.cppreference.com/w/cpp/named_req/TrivialClock) used by
+ *  the matching TimerRegistry.
+ */
+template <typename Clock = DefaultClock>
+class CallTree {
+  public:
+    using clock = Clock;
+    using duration = typename clock::duration;
+    using node_type = CallTreeNode<duration>;
+
+    /** @brief Index of the root node */
+    static constexpr std::size_t ROOT = 0;
+
+    CallTree() {
+        nodes_.push_back(
+            node_type{TimerHandle(std::numeric_limits<std::size_t>::max()), ROOT, {}});
+    }
+
+    /**
+     * @brief Returns the index of the node for `timer` run inside `parent`, adding it if this is
+     *  the first time `timer` was run there.
+     */
+    std::size_t InsertOrLookupChild(std::size_t parent, TimerHandle timer) {
+        auto const &children = nodes_[parent].children;
+        auto const it = std::find_if(children.cbegin(), children.cend(), [&](auto const child) {
+            return nodes_[child].timer == timer;
+        });
+
+        if (it != children.cend()) {
+            return *it;
+        }
+
+        nodes_.push_back(node_type{timer, parent, {}});
+        nodes_[parent].children.push_back(nodes_.size() - 1);
+        return nodes_.size() - 1;
+    }
+
+    /**
+     * @brief Records one run of `node` that lasted `time`
+     */
+    void Record(std::size_t node, duration time) {
+        auto &run = nodes_[node];
+        run.count += 1;
+        run.inclusive_time += time;
+
+        if (node != ROOT) {
+            nodes_[run.parent].children_time += time;
+        }
+    }
+
+    /**
+     * @brief Adds the runs recorded in `other` to this tree, matching nodes by their path.
+     *
+     * @param other
+     *  The tree to merge in
+     * @param to_this
+     *  Called as `to_this(TimerHandle)` to convert a timer of `other` into the matching timer used
+     *  by this tree.
+     */
+    template <typename Fn>
+    void Merge(CallTree const &other, Fn &&to_this) {
+        // Parents are always stored before their children, so their matches are already known
+        std::vector<std::size_t> matching(other.nodes_.size(), ROOT);
+        for (std::size_t i = 1; i < other.nodes_.size(); i++) {
+            auto const &other_node = other.nodes_[i];
+
+            matching[i] =
+                InsertOrLookupChild(matching[other_node.parent], to_this(other_node.timer));
+
+            auto &node = nodes_[matching[i]];
+            node.count += other_node.count;
+            node.inclusive_time += other_node.inclusive_time;
+            node.children_time += other_node.children_time;
+        }
+    }
+
+    /** @brief Returns the node at `index` */
+    node_type const &GetNode(std::size_t index) const { return nodes_[index]; }
+
+    /** @brief Returns the number of nodes, including the root */
+    std::size_t Count() const { return nodes_.size(); }
+
+    /**
+     * @brief Visits every node but the root in depth-first order, children in the order they were
+     *  first run.
+     *
+     * @param fn
+     *  Called as `fn(std::size_t index, node_type const &node, std::size_t depth)`. Children of the
+     *  root have a depth of 0.
+     */
+    template <typename Fn>
+    void Walk(Fn &&fn) const {
+        std::vector<std::pair<std::size_t, std::size_t>> pending;
+
+        auto const push_children = [&](std::size_t index, std::size_t depth) {
+            auto const &children = nodes_[index].children;
+            for (auto it = children.crbegin(); it != children.crend(); ++it) {
+                pending.emplace_back(*it, depth);
+            }
+        };
+
+        push_children(ROOT, 0);
+        while (!pending.empty()) {
+            auto const next = pending.back();
+            pending.pop_back();
+
+            fn(next.first, nodes_[next.first], next.second);
+            push_children(next.first, next.second + 1);
+        }
+    }
+
+  private:
+    std::vector<node_type> nodes_;
+};
+
+template <typename Clock>
+constexpr std::size_t CallTree<Clock>::ROOT;
+
+namespace internal {
+/**
+ * @brief FNV-1a hash of a string_view, so timer names can be looked up without building a
+ *  std::string.
+ */
+struct TimerNameHash {
+    std::size_t operator()(nonstd::string_view name) const noexcept {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (auto const c : name) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return static_cast<std::size_t>(hash);
+    }
+};
+} // namespace internal
+
+/**
+ * @brief How a TimerRegistry times timers pushed onto a non-empty timer stack.
+ */
+enum class TimingMode {
+    /// Only the outermost timer on the stack is timed
+    Outermost,
+    /// Every timer is timed, and runs are also accumulated per call path in a CallTree
+    CallTree,
+};
+
 /**
  * @brief A collection of associated timers that can be started and tracked simultaneously.
  *
  * @details
  *  TimerRegistry track timer runs using a stack. Ergo, timers must be popped in the reverse order
- *  of the order they were pushed on the stack. Only the outermost (i.e. bottom timer on the stack)
+ *  of the order they were pushed on the stack.
+ *
+ *  In the default TimingMode::Outermost, only the outermost (i.e. bottom timer on the stack)
  *  is actually started when its pushed onto an empty stack and stopped when it is popped (making
  *  the stack empty again). Even though additional timers pushed onto a non-empty stack won't be
  *  started or stopped, the stack exists to allow timers to be pushed onto the stack inside
@@ -142,6 +341,10 @@ class TimerRegistryRange {
  *  directly, because it is being timed as part of the outermost timer that was pushed onto the
  *  stack at an earlier point.
  *
+ *  In TimingMode::CallTree, every push is timed. Each Timer accumulates its outermost run only,
+ *  so recursive timers aren't counted twice, and every (parent path, timer) pair accumulates
+ *  inclusive and exclusive time in the registry's CallTree.
+ *
  *  It is recommended to always use \ref TimedSection produced by the \ref TimeSection methods, as
  *  they will automatically pop timers from the stack in the reverse order of which they were
  *  pushed.
@@ -152,9 +355,8 @@ class TimerRegistryRange {
  *  TimerRegistry value as TimerRegistry<>.
  *
  *  TimerRegistry is not thread-safe, and its stack-based implementation does not make it amenable
- *  for use across multiple threads. If you want to time operations across multiple threads,
- *  then your best option is to create a TimerRegistry per-thread and accumulate the results at the
- *  end of the run.
+ *  for use across multiple threads. To time operations across multiple threads, use
+ *  ThreadedTimerRegistry, which gives each thread its own TimerRegistry and merges them on demand.
  *
  * @tparam DefaultClock
  *  The C++ STL [TrivialClock](https://en.cppreference.com/w/cpp/named_req/TrivialClock) used by
@@ -169,26 +371,266 @@ class TimerRegistry {
      */
     using clock = Clock;
 
+    TimerRegistry() = default;
+
+    /**
+     * @brief Creates an empty TimerRegistry using `mode`
+     */
+    explicit TimerRegistry(TimingMode mode) : mode_(mode) {}
+
+    TimerRegistry(TimerRegistry const &other)
+        : mode_(other.mode_),
+          histograms_(other.histograms_),
+          counters_(other.counters_),
+          names_(other.names_),
+          timers_(other.timers_),
+          current_timers_(other.current_timers_),
+          call_tree_(other.call_tree_),
+          trace_(other.trace_) {
+        // The index refers to the names of `other`, so it has to be rebuilt over the copies
+        name_index_.reserve(names_.size());
+        for (std::size_t i = 0; i < names_.size(); i++) {
+            name_index_.emplace(names_[i], i);
+        }
+    }
+
+    TimerRegistry &operator=(TimerRegistry const &other) {
+        if (this != &other) {
+            *this = TimerRegistry(other);
+        }
+        return *this;
+    }
+
+    // Moving names_ keeps its strings in place, so the index stays valid
+    TimerRegistry(TimerRegistry &&) = default;
+    TimerRegistry &operator=(TimerRegistry &&) = default;
+
+    /**
+     * @brief Returns how timers pushed onto a non-empty stack are timed
+     */
+    TimingMode GetTimingMode() const { return mode_; }
+
+    /**
+     * @brief Changes how timers pushed onto a non-empty stack are timed.
+     *
+     * @details
+     *  Terminates the program if a timer is on the stack. Switching to TimingMode::CallTree keeps
+     *  the call tree recorded by any earlier TimingMode::CallTree runs.
+     */
+    void SetTimingMode(TimingMode mode) {
+        if (!current_timers_.empty()) {
+            std::cerr << "eap::perf::TimerRegistry::SetTimingMode(): The timing mode can only be "
+                         "changed while no timers are running!"
+                      << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+
+        mode_ = mode;
+    }
+
+    /**
+     * @brief Returns the call tree recorded while in TimingMode::CallTree
+     */
+    CallTree<Clock> const &GetCallTree() const { return call_tree_; }
+
+    /**
+     * @brief Writes the call tree as an indented list, one node per line.
+     *
+     * @details
+     *  Example output:
+     *  ```
+     *  foo: count = 10, inclusive = 1200 ns, exclusive = 400 ns
+     *    bar: count = 20, inclusive = 800 ns, exclusive = 800 ns
+     *  ```
+     */
+    void PrintCallTree(std::ostream &os) const {
+        using std::chrono::duration_cast;
+        using std::chrono::nanoseconds;
+
+        call_tree_.Walk([&](std::size_t, auto const &node, std::size_t depth) {
+            os << std::string(2 * depth, ' ') << GetTimerName(node.timer)
+               << ": count = " << node.count << ", inclusive = "
+               << duration_cast<nanoseconds>(node.inclusive_time).count() << " ns, exclusive = "
+               << duration_cast<nanoseconds>(node.ExclusiveTime()).count() << " ns\n";
+        });
+    }
+
+    /**
+     * @brief Records the run-times of every timer, including timers registered later, into a
+     *  histogram so that Timer::Percentile can be used. See Timer::EnableHistogram.
+     */
+    void EnableHistograms() {
+        histograms_ = true;
+        for (auto &timer : timers_) {
+            timer.EnableHistogram();
+        }
+    }
+
+    /**
+     * @brief Accumulates the calling thread's hardware counters over the runs of every timer,
+     *  including timers registered later. See Timer::EnableCounters and CounterGroup.
+     *
+     * @details
+     *  Like run-times, nested runs are only counted in TimingMode::CallTree. Timers must be pushed
+     *  and popped on the thread that enabled the counters.
+     *
+     * @return bool
+     *  Whether the calling thread can read any counter. If not, runs are still counted, but
+     *  without events.
+     */
+    bool EnableCounters() {
+        counters_ = true;
+        for (auto &timer : timers_) {
+            timer.EnableCounters();
+        }
+        return HardwareCountersAvailable();
+    }
+
+    /**
+     * @brief Writes the hardware counters of each timer that counted a run, one timer per line,
+     *  with the instructions per cycle and the misses per 1000 instructions. Events that couldn't
+     *  be counted are written as "n/a".
+     *
+     * @details
+     *  Example line, wrapped here:
+     *  ```
+     *  foo: runs = 10, cycles = 52000, instructions = 98000, IPC = 1.88, LLC misses = 120
+     *  (1.22 per 1000 instructions), branch misses = 30 (0.306 per 1000 instructions)
+     *  ```
+     */
+    void PrintCounters(std::ostream &os) const {
+        auto const print_count = [&](HardwareCounters const &counters,
+                                     HardwareEvent event,
+                                     std::uint64_t count) {
+            if (counters.Counted(event)) {
+                os << count;
+            } else {
+                os << "n/a";
+            }
+        };
+        auto const print_ratio = [&](nonstd::optional<double> ratio) {
+            if (ratio) {
+                os << ratio.value();
+            } else {
+                os << "n/a";
+            }
+        };
+
+        auto const precision = os.precision(3);
+        for (std::size_t i = 0; i < timers_.size(); i++) {
+            auto const *counters = timers_[i].GetCounters();
+            if (!counters || counters->runs == 0) {
+                continue;
+            }
+
+            os << names_[i] << ": runs = " << counters->runs << ", cycles = ";
+            print_count(*counters, HardwareEvent::Cycles, counters->cycles);
+            os << ", instructions = ";
+            print_count(*counters, HardwareEvent::Instructions, counters->instructions);
+            os << ", IPC = ";
+            print_ratio(counters->Ipc());
+            os << ", LLC misses = ";
+            print_count(*counters, HardwareEvent::LlcMisses, counters->llc_misses);
+            os << " (";
+            print_ratio(counters->LlcMissesPerKiloInstruction());
+            os << " per 1000 instructions), branch misses = ";
+            print_count(*counters, HardwareEvent::BranchMisses, counters->branch_misses);
+            os << " (";
+            print_ratio(counters->BranchMissesPerKiloInstruction());
+            os << " per 1000 instructions)\n";
+        }
+        os.precision(precision);
+    }
+
+    /**
+     * @brief Starts recording every run of every timer, including nested runs, into a ring buffer
+     *  of `capacity` events. A capacity of 0 stops recording.
+     *
+     * @details
+     *  The buffer is allocated here, so recording an event never allocates. Once full, new events
+     *  overwrite the oldest ones. Recorded events are kept when the capacity changes, as far as
+     *  they fit. See perf-chrome_trace.hpp for writing them out.
+     */
+    void EnableTracing(std::size_t capacity) { trace_.Resize(capacity); }
+
+    /** @brief Returns whether runs are being recorded into GetTrace() */
+    bool IsTracing() const { return trace_.Capacity() > 0; }
+
+    /** @brief Returns the recorded runs. See EnableTracing. */
+    TraceBuffer const &GetTrace() const { return trace_; }
+
+    /** @brief Discards the recorded runs, keeping the capacity */
+    void ClearTrace() { trace_.Clear(); }
+
     /**
      * @brief Converts a human-readable timer name into a TimerHandle. If a timer has not been
      *  previously registered with that name, the timer is registered.
      *
+     * @details
+     *  Constant time on average. Looking up an existing name doesn't allocate, so callers that
+     *  can't cache the TimerHandle, such as FFI users, can look it up on every call.
+     *
      * @param timer_name
      *  Human readable label for timer
      * @return TimerHandle
      *  a handle to the Timer object managed by TimerRegistry
      */
     TimerHandle InsertOrLookupTimer(nonstd::string_view timer_name) {
-        auto const it = std::find_if(timers_.cbegin(), timers_.cend(), [&](auto const &timer) {
-            return timer.first == timer_name;
-        });
+        auto const it = name_index_.find(timer_name);
+        if (it != name_index_.cend()) {
+            return TimerHandle(it->second);
+        }
 
-        if (it != timers_.cend()) {
-            return TimerHandle(it - timers_.cbegin());
-        } else {
-            timers_.push_back(std::make_pair(nonstd::to_string(timer_name), Timer<Clock>()));
-            return TimerHandle(timers_.size() - 1);
+        names_.push_back(nonstd::to_string(timer_name));
+        timers_.emplace_back();
+        if (histograms_) {
+            timers_.back().EnableHistogram();
         }
+        if (counters_) {
+            timers_.back().EnableCounters();
+        }
+        name_index_.emplace(names_.back(), timers_.size() - 1);
+
+        return TimerHandle(timers_.size() - 1);
+    }
+
+    /**
+     * @brief Adds the timers and call tree recorded in `other` to this registry.
+     *
+     * @details
+     *  Timers are matched by name, and timers only in `other` are registered. Runs that are still
+     *  in progress in `other` aren't included. Traced events of `other` are appended to this
+     *  registry's trace, which grows to hold them, and the events `other` overwrote are added to
+     *  its NumOverwritten(). Use this to combine registries recorded on separate threads; `other`
+     *  must not be modified while it's merged.
+     *
+     * @param other
+     *  The registry to merge in. Unchanged.
+     */
+    void Merge(TimerRegistry const &other) {
+        std::vector<TimerHandle> to_this;
+        to_this.reserve(other.timers_.size());
+
+        for (std::size_t i = 0; i < other.timers_.size(); i++) {
+            auto const handle = InsertOrLookupTimer(other.names_[i]);
+            timers_[handle.index_].Merge(other.timers_[i]);
+            to_this.push_back(handle);
+        }
+
+        call_tree_.Merge(other.call_tree_,
+                         [&](TimerHandle other_handle) { return to_this[other_handle.index_]; });
+
+        // Keep every event of both, growing the buffer if needed
+        auto const num_events = trace_.Size() + other.trace_.Size();
+        if (other.trace_.Size() > 0 && trace_.Capacity() < num_events) {
+            trace_.Resize(num_events);
+        }
+
+        other.trace_.ForEach([&](TraceEvent event) {
+            event.timer = to_this[event.timer].index_;
+            trace_.Record(event);
+        });
+        trace_.AddOverwritten(other.trace_.NumOverwritten());
     }
 
     /**
@@ -200,7 +642,7 @@ class TimerRegistry {
      *  An immutable reference to the name of the timer associated with index
      */
     nonstd::string_view GetTimerName(TimerHandle index) const {
-        return timers_[index.index_].first;
+        return names_[index.index_];
     }
 
     /**
@@ -211,31 +653,47 @@ class TimerRegistry {
      * @return Timer<Clock> const&
      *  Immutable reference to timer associated with index. Used to retrieve statistics.
      */
-    Timer<Clock> const &GetTimer(TimerHandle index) const { return timers_[index.index_].second; }
+    Timer<Clock> const &GetTimer(TimerHandle index) const { return timers_[index.index_]; }
 
     /**
      * @brief Pushes a timer onto the current timer stack, starting it if the stack is empty.
      *
      * @details
-     *  TimerRegistry will only track time for the outermost timer, which is the bottom timer in
-     *  the stack.
+     *  In TimingMode::Outermost, TimerRegistry will only track time for the outermost timer, which
+     *  is the bottom timer in the stack. In TimingMode::CallTree, every timer is tracked.
      *
      * @param index
      *  Handle to Timer in Registry. Behavior undefined if handle came from different TimerRegistry.
      */
     void PushTimer(TimerHandle index) {
-        if (current_timers_.empty()) {
-            auto &timer_registration = timers_.at(index.index_);
-
-            auto &timer = timer_registration.second;
+        Frame frame{index, CallTree<Clock>::ROOT, false, time_point()};
+
+        if (mode_ == TimingMode::CallTree) {
+            auto const parent =
+                current_timers_.empty() ? CallTree<Clock>::ROOT : current_timers_.top().node;
+            frame.node = call_tree_.InsertOrLookupChild(parent, index);
+
+            // Only the outermost run of a recursive timer is added to its Timer
+            auto &timer = timers_.at(index.index_);
+            if (!timer.IsRunning()) {
+                timer.Start();
+                frame.started = true;
+            }
+        } else if (current_timers_.empty()) {
+            auto &timer = timers_.at(index.index_);
             if (timer.IsRunning()) {
-                throw TimerAlreadyRunningException(timer_registration.first);
+                throw TimerAlreadyRunningException(names_[index.index_]);
             }
 
             timer.Start();
+            frame.started = true;
         }
 
-        current_timers_.push(index);
+        if (mode_ == TimingMode::CallTree || IsTracing()) {
+            frame.start = clock::now();
+        }
+
+        current_timers_.push(frame);
     }
 
     /**
@@ -255,12 +713,24 @@ class TimerRegistry {
             std::exit(EXIT_FAILURE);
         }
 
-        auto const index = current_timers_.top();
-        if (current_timers_.size() == 1) {
-            timers_[index.index_].second.Stop();
+        auto const frame = current_timers_.top();
+        if (mode_ == TimingMode::CallTree || IsTracing()) {
+            auto const end = clock::now();
+
+            if (mode_ == TimingMode::CallTree) {
+                call_tree_.Record(frame.node, end - frame.start);
+            }
+
+            if (IsTracing()) {
+                trace_.Record(TraceEvent{
+                    frame.timer.index_, ThreadIndex(), SinceEpoch(frame.start), SinceEpoch(end)});
+            }
+        }
+        if (frame.started) {
+            timers_[frame.timer.index_].Stop();
         }
         current_timers_.pop();
-        return index;
+        return frame.timer;
     }
 
     /**
@@ -271,8 +741,8 @@ class TimerRegistry {
      *  You must assign the return value to a member, otherwise the timer will start and immediately
      *  stop.
      *
-     *  The specified timer is only started if the current stack is empty, i.e. if there isn't
-     *  another outer timer or TimedSection.
+     *  In TimingMode::Outermost, the specified timer is only started if the current stack is
+     *  empty, i.e. if there isn't another outer timer or TimedSection.
      *
      *  E.g.
      *  ```cpp
@@ -339,8 +809,35 @@ class TimerRegistry {
     std::size_t Count() const { return timers_.size(); }
 
   private:
-    std::vector<std::pair<std::string, Timer<clock>>> timers_;
-    std::stack<TimerHandle> current_timers_;
+    using time_point = typename clock::time_point;
+
+    /// A timer on the timer stack
+    struct Frame {
+        TimerHandle timer;
+        /// Node in call_tree_. Only used in TimingMode::CallTree.
+        std::size_t node;
+        /// Whether this push started the Timer, and so its pop must stop it
+        bool started;
+        /// When the timer was pushed. Only used in TimingMode::CallTree or while tracing.
+        time_point start;
+    };
+
+    TimingMode mode_ = TimingMode::Outermost;
+    bool histograms_ = false;
+    bool counters_ = false;
+    /// Interned timer names, indexed by TimerHandle. A deque never moves its elements, so
+    /// name_index_ can refer to them.
+    std::deque<std::string> names_;
+    std::vector<Timer<clock>> timers_;
+    std::unordered_map<nonstd::string_view, std::size_t, internal::TimerNameHash> name_index_;
+    std::stack<Frame> current_timers_;
+    CallTree<Clock> call_tree_;
+    TraceBuffer trace_;
+
+    static std::int64_t SinceEpoch(time_point const &time) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch())
+            .count();
+    }
 };
 
 /**
@@ -0,0 +1,215 @@
+/**
+ * @brief Implements a collection of per-thread TimerRegistry objects that record without locking
+ *  and are merged on demand.
+ *
+ * @file perf-threaded_registry.hpp
+ *
+ * @date 2019-09-24
+ */
+
+#ifndef EAP_PERF_THREADED_REGISTRY_HPP
+#define EAP_PERF_THREADED_REGISTRY_HPP
+
+#include "perf-clock.hpp"
+#include "perf-registry.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace eap {
+namespace perf {
+
+/**
+ * @brief Gives each thread its own TimerRegistry and merges them into a single view on demand.
+ *
+ * @details
+ *  TimerRegistry is not thread-safe. Rather than guarding it with a lock, which every timed section
+ *  on every thread would contend on, ThreadedTimerRegistry hands each thread a registry of its own
+ *  through Local(). Starting and stopping timers then touches only thread-local state. The only
+ *  lock is taken the first time a thread calls Local(), and by Merged().
+ *
+ *  A TimerHandle is only valid for the registry it came from, so handles must be looked up in the
+ *  calling thread's registry. Caching a handle in a `static thread_local` variable is the cheap way
+ *  to do that.
+ *
+ *  Merged() reads every thread's registry, so it must only be called while the other threads
+ *  aren't timing anything, e.g. after joining them or outside of a parallel region.
+ *
+ *  Per-thread registries are kept until ThreadedTimerRegistry is destroyed, so timers recorded by
+ *  threads that have since exited are still merged. ThreadedTimerRegistry must outlive any thread
+ *  still using a registry returned by Local().
+ *
+ * @tparam Clock
+ *  The clock used by the per-thread registries.
+ *
+ * @code
+ *  static ThreadedTimerRegistry<> timers;
+ *
+ *  #pragma omp parallel
+ *  {
+ *      static thread_local TimerHandle const handle = timers.Local().InsertOrLookupTimer("work");
+ *      auto const section = timers.Local().TimeSection(handle);
+ *      DoWork();
+ *  }
+ *
+ *  auto merged = timers.Merged();
+ *  for (auto handle : merged.Timers()) {
+ *      std::cout << merged.GetTimerName(handle) << ": " << merged.GetTimer(handle).TimerCount();
+ *  }
+ * @endcode
+ */
+template <typename Clock = DefaultClock>
+class ThreadedTimerRegistry {
+  public:
+    using registry_type = TimerRegistry<Clock>;
+
+    /**
+     * @brief Constructs an empty ThreadedTimerRegistry.
+     *
+     * @param mode
+     *  TimingMode of each per-thread registry.
+     */
+    explicit ThreadedTimerRegistry(TimingMode mode = TimingMode::Outermost)
+        : id_(NextId()), mode_(mode) {}
+
+    ThreadedTimerRegistry(ThreadedTimerRegistry const &) = delete;
+    ThreadedTimerRegistry &operator=(ThreadedTimerRegistry const &) = delete;
+
+    /**
+     * @brief Returns the calling thread's registry, creating it on the thread's first call.
+     *
+     * @details
+     *  Lock-free after the first call on each thread.
+     */
+    registry_type &Local() {
+        // Keyed by id_ rather than by address, so a ThreadedTimerRegistry created where a
+        // destroyed one used to live never picks up its stale entries.
+        thread_local std::vector<std::pair<std::size_t, registry_type *>> local_registries;
+
+        for (auto const &local : local_registries) {
+            if (local.first == id_) {
+                return *local.second;
+            }
+        }
+
+        registry_type *registry;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            registries_.push_back(std::make_unique<registry_type>(mode_));
+            registry = registries_.back().get();
+            registry->EnableTracing(trace_capacity_);
+            if (histograms_) {
+                registry->EnableHistograms();
+            }
+            if (counters_) {
+                registry->EnableCounters();
+            }
+        }
+
+        local_registries.emplace_back(id_, registry);
+        return *registry;
+    }
+
+    /**
+     * @brief Returns a registry with the timers of every thread merged by name.
+     *
+     * @details
+     *  See TimerRegistry::Merge. Other threads must not be timing while this is called.
+     */
+    registry_type Merged() const {
+        registry_type merged(mode_);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto const &registry : registries_) {
+            merged.Merge(*registry);
+        }
+
+        return merged;
+    }
+
+    /**
+     * @brief Enables tracing with room for `capacity` events on every thread, including threads
+     *  that haven't called Local() yet. See TimerRegistry::EnableTracing.
+     *
+     * @details
+     *  Other threads must not be timing while this is called. Merged() combines the traces of all
+     *  threads, each event keeping the ThreadIndex of the thread that recorded it.
+     */
+    void EnableTracing(std::size_t capacity) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        trace_capacity_ = capacity;
+        for (auto &registry : registries_) {
+            registry->EnableTracing(capacity);
+        }
+    }
+
+    /**
+     * @brief Enables run-time histograms on every thread, including threads that haven't called
+     *  Local() yet. See TimerRegistry::EnableHistograms.
+     *
+     * @details
+     *  Other threads must not be timing while this is called.
+     */
+    void EnableHistograms() {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        histograms_ = true;
+        for (auto &registry : registries_) {
+            registry->EnableHistograms();
+        }
+    }
+
+    /**
+     * @brief Enables hardware counters on every thread, including threads that haven't called
+     *  Local() yet. See TimerRegistry::EnableCounters.
+     *
+     * @details
+     *  Other threads must not be timing while this is called. Each thread counts with its own
+     *  CounterGroup, so Merged() sums the counts of all threads.
+     *
+     * @return bool
+     *  Whether the calling thread can read any counter
+     */
+    bool EnableCounters() {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        counters_ = true;
+        for (auto &registry : registries_) {
+            registry->EnableCounters();
+        }
+        return HardwareCountersAvailable();
+    }
+
+    /**
+     * @brief Returns the number of threads that have called Local().
+     */
+    std::size_t NumThreads() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return registries_.size();
+    }
+
+  private:
+    static std::size_t NextId() {
+        static std::atomic<std::size_t> next_id{0};
+        return next_id++;
+    }
+
+    std::size_t const id_;
+    TimingMode const mode_;
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<registry_type>> registries_;
+    std::size_t trace_capacity_ = 0;
+    bool histograms_ = false;
+    bool counters_ = false;
+};
+
+} // namespace perf
+} // namespace eap
+
+#endif // EAP_PERF_THREADED_REGISTRY_HPP
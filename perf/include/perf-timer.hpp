@@ -1,6 +1,6 @@
 /**
  * @brief Implements a timer type that tracks runtime of some computation and maintains running
- *  statistics, including min, max, sum, and average.
+ *  statistics, including min, max, sum, average, and optionally percentiles and hardware counters.
  *
  * @file perf-timer.hpp
  *
@@ -13,8 +13,13 @@
 #include "perf-internal-fwd.hpp"
 
 #include "perf-clock.hpp"
+#include "perf-counters.hpp"
 #include "perf-error.hpp"
+#include "perf-histogram.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <memory>
 #include <nonstd/optional.hpp>
 #include <stdexcept>
 
@@ -34,6 +39,29 @@ class Timer {
     using clock = Clock;
     using duration = typename clock::duration;
     using time_point = typename clock::time_point;
+    using histogram_type = DurationHistogram<duration>;
+
+    Timer() = default;
+
+    Timer(Timer const &other)
+        : timer_count_(other.timer_count_),
+          sum_time_(other.sum_time_),
+          min_time_(other.min_time_),
+          max_time_(other.max_time_),
+          start_time_(other.start_time_),
+          histogram_(other.histogram_ ? std::make_unique<histogram_type>(*other.histogram_)
+                                      : nullptr),
+          counters_(other.counters_ ? std::make_unique<CounterState>(*other.counters_) : nullptr) {}
+
+    Timer &operator=(Timer const &other) {
+        if (this != &other) {
+            *this = Timer(other);
+        }
+        return *this;
+    }
+
+    Timer(Timer &&) = default;
+    Timer &operator=(Timer &&) = default;
 
     /**
      * @brief Put the Timer into the running state.
@@ -47,6 +75,12 @@ class Timer {
             throw TimerAlreadyRunningException();
         }
 
+        // Read the counters outside of the timed interval, so that reading them isn't timed
+        if (counters_) {
+            counters_->start = CounterGroup::Local().Read();
+            counters_->running = true;
+        }
+
         start_time_ = clock::now();
     }
 
@@ -77,6 +111,50 @@ class Timer {
             min_time_ = time;
             max_time_ = time;
         }
+
+        if (histogram_) {
+            histogram_->Record(time);
+        }
+
+        if (counters_ && counters_->running) {
+            counters_->total.AddRun(counters_->start, CounterGroup::Local().Read());
+            counters_->running = false;
+        }
+    }
+
+    /**
+     * @brief Adds the statistics of the completed runs of `other` to this Timer.
+     *
+     * @details
+     *  Used to combine timers recorded separately, e.g. on different threads. A run of `other`
+     *  that is still in progress is not included, and doesn't affect whether this Timer is
+     *  running.
+     */
+    void Merge(Timer const &other) {
+        if (other.timer_count_ == 0) {
+            return;
+        }
+
+        if (other.histogram_) {
+            EnableHistogram();
+            histogram_->Merge(*other.histogram_);
+        }
+
+        if (other.counters_) {
+            EnableCounters();
+            counters_->total += other.counters_->total;
+        }
+
+        timer_count_ += other.timer_count_;
+        sum_time_ += other.sum_time_;
+
+        if (min_time_) {
+            min_time_ = std::min(min_time_.value(), other.min_time_.value());
+            max_time_ = std::max(max_time_.value(), other.max_time_.value());
+        } else {
+            min_time_ = other.min_time_;
+            max_time_ = other.max_time_;
+        }
     }
 
     /**
@@ -128,6 +206,66 @@ class Timer {
      */
     bool IsRunning() const { return start_time_.has_value(); }
 
+    /**
+     * @brief Starts recording each run into a histogram, so that Percentile can be used.
+     *
+     * @details
+     *  Allocates the histogram's fixed set of buckets once, so recording runs never allocates.
+     *  Runs completed before the histogram was enabled aren't in it. Does nothing if the histogram
+     *  is already enabled.
+     */
+    void EnableHistogram() {
+        if (!histogram_) {
+            histogram_ = std::make_unique<histogram_type>();
+        }
+    }
+
+    /**
+     * @brief Returns the histogram of run-times, or nullptr if EnableHistogram wasn't called.
+     */
+    histogram_type const *GetHistogram() const { return histogram_.get(); }
+
+    /**
+     * @brief Starts accumulating the hardware counters of the calling thread's CounterGroup over
+     *  each run, so that GetCounters can be used.
+     *
+     * @details
+     *  Every run reads the counters twice, each a system call, so this is meant for sections that
+     *  run for at least a few microseconds. The runs must start and stop on the same thread. If
+     *  counters aren't available, runs are still counted but no events are. Runs completed or
+     *  started before the counters were enabled aren't counted. Does nothing if already enabled.
+     */
+    void EnableCounters() {
+        if (!counters_) {
+            counters_ = std::make_unique<CounterState>();
+        }
+    }
+
+    /**
+     * @brief Returns the hardware counters summed over the runs, or nullptr if EnableCounters
+     *  wasn't called. See HardwareCounters::Ipc for derived metrics.
+     */
+    HardwareCounters const *GetCounters() const { return counters_ ? &counters_->total : nullptr; }
+
+    /**
+     * @brief Estimates a percentile of the Timer run-times, with a relative error of at most
+     *  1 / histogram_type::SUB_BUCKETS.
+     *
+     * @param percentile
+     *  In [0, 100], e.g. 50 for the median or 99.9
+     * @return Optional std::chrono::duration object. Returns nonstd::nullopt if the histogram isn't
+     *  enabled or no runs have been recorded in it.
+     */
+    nonstd::optional<duration> Percentile(double percentile) const {
+        auto const estimate = histogram_ ? histogram_->Percentile(percentile) : nonstd::nullopt;
+        if (!estimate) {
+            return nonstd::nullopt;
+        }
+
+        // The bucket's upper bound can be beyond any run
+        return std::min(estimate.value(), max_time_.value());
+    }
+
   private:
     std::size_t timer_count_ = 0;
     duration sum_time_{0};
@@ -135,6 +273,18 @@ class Timer {
     nonstd::optional<duration> max_time_;
 
     nonstd::optional<time_point> start_time_;
+
+    /// Only allocated when enabled, since most timers don't need it
+    std::unique_ptr<histogram_type> histogram_;
+
+    struct CounterState {
+        HardwareCounters total;
+        /// Reading at the start of the current run
+        HardwareCounters start;
+        /// Whether the current run started with counters enabled
+        bool running = false;
+    };
+    std::unique_ptr<CounterState> counters_;
 };
 
 } // namespace perf
@@ -0,0 +1,141 @@
+/**
+ * @brief Implements a fixed-capacity ring buffer of timed-section events, used by TimerRegistry to
+ *  record a timeline of every section it times.
+ *
+ * @file perf-trace.hpp
+ *
+ * @date 2019-09-26
+ */
+
+#ifndef EAP_PERF_TRACE_HPP
+#define EAP_PERF_TRACE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace eap {
+namespace perf {
+
+/**
+ * @brief One run of a timer, as recorded by a TimerRegistry with tracing enabled.
+ */
+struct TraceEvent {
+    /// Index of the timer in the TimerRegistry that recorded the event. See TimerHandle.
+    std::size_t timer;
+    /// Small integer identifying the thread that recorded the event. See ThreadIndex.
+    std::uint32_t thread;
+    /// Start of the run, in nanoseconds since the clock's epoch
+    std::int64_t begin;
+    /// End of the run, in nanoseconds since the clock's epoch
+    std::int64_t end;
+};
+
+/**
+ * @brief Returns a small integer identifying the calling thread, numbered from 0 in the order that
+ *  threads first call ThreadIndex.
+ */
+inline std::uint32_t ThreadIndex() {
+    static std::atomic<std::uint32_t> next_index{0};
+    thread_local std::uint32_t const index = next_index++;
+    return index;
+}
+
+/**
+ * @brief A ring buffer of TraceEvent objects allocated once, up-front.
+ *
+ * @details
+ *  Record never allocates, so recording costs the same whether or not the buffer is full. Once
+ *  full, each new event overwrites the oldest one, so the buffer always holds the most recent
+ *  Capacity() events, and NumOverwritten() counts the events lost.
+ *
+ *  A TraceBuffer with a capacity of 0 records nothing.
+ */
+class TraceBuffer {
+  public:
+    TraceBuffer() = default;
+
+    /**
+     * @brief Allocates room for `capacity` events.
+     */
+    explicit TraceBuffer(std::size_t capacity) : events_(capacity) {}
+
+    /**
+     * @brief Appends `event`, overwriting the oldest event if the buffer is full.
+     */
+    void Record(TraceEvent const &event) noexcept {
+        if (events_.empty()) {
+            return;
+        }
+
+        events_[next_] = event;
+        next_ = next_ + 1 == events_.size() ? 0 : next_ + 1;
+
+        if (size_ < events_.size()) {
+            size_++;
+        } else {
+            num_overwritten_++;
+        }
+    }
+
+    /**
+     * @brief Calls `fn(TraceEvent const &)` on each held event, oldest first.
+     */
+    template <typename Fn>
+    void ForEach(Fn &&fn) const {
+        auto const first = size_ < events_.size() ? 0 : next_;
+        for (std::size_t i = 0; i < size_; i++) {
+            auto const index = first + i;
+            fn(events_[index < events_.size() ? index : index - events_.size()]);
+        }
+    }
+
+    /**
+     * @brief Changes the capacity to `capacity`, keeping the most recent events that fit.
+     *
+     * @details
+     *  Allocates, so it shouldn't be called while timing.
+     */
+    void Resize(std::size_t capacity) {
+        TraceBuffer resized(capacity);
+        resized.num_overwritten_ = num_overwritten_;
+        ForEach([&](TraceEvent const &event) { resized.Record(event); });
+
+        *this = std::move(resized);
+    }
+
+    /**
+     * @brief Adds `count` to NumOverwritten(), e.g. for the events another buffer lost before its
+     * events were copied into this one.
+     */
+    void AddOverwritten(std::size_t count) noexcept { num_overwritten_ += count; }
+
+    /** @brief Removes every event, keeping the capacity */
+    void Clear() noexcept {
+        next_ = 0;
+        size_ = 0;
+        num_overwritten_ = 0;
+    }
+
+    /** @brief Maximum number of events held at once */
+    std::size_t Capacity() const noexcept { return events_.size(); }
+
+    /** @brief Number of events held */
+    std::size_t Size() const noexcept { return size_; }
+
+    /** @brief Number of events lost because the buffer was full */
+    std::size_t NumOverwritten() const noexcept { return num_overwritten_; }
+
+  private:
+    std::vector<TraceEvent> events_;
+    std::size_t next_ = 0;
+    std::size_t size_ = 0;
+    std::size_t num_overwritten_ = 0;
+};
+
+} // namespace perf
+} // namespace eap
+
+#endif // EAP_PERF_TRACE_HPP
@@ -13,10 +13,15 @@
 
 #include "perf-internal-fwd.hpp"
 
+#include "perf-chrome_trace.hpp"
 #include "perf-clock.hpp"
+#include "perf-counters.hpp"
 #include "perf-error.hpp"
+#include "perf-histogram.hpp"
 #include "perf-registry.hpp"
+#include "perf-threaded_registry.hpp"
 #include "perf-timer.hpp"
+#include "perf-trace.hpp"
 
 /**
  * @dir perf
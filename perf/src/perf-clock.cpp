@@ -0,0 +1,149 @@
+#include <perf-clock.hpp>
+
+#include <utility-fast_divide.hpp>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define EAP_PERF_HAS_TSC 1
+#include <cpuid.h>
+#include <x86intrin.h>
+#else
+#define EAP_PERF_HAS_TSC 0
+#endif
+
+using eap::perf::TscClock;
+using std::chrono::steady_clock;
+
+namespace {
+/// How long the TSC is compared against steady_clock to calibrate its rate
+constexpr auto CALIBRATION_TIME = std::chrono::milliseconds(5);
+
+/// Fractional bits of TscCalibration::ns_per_tick
+constexpr unsigned NS_PER_TICK_SHIFT = 32;
+
+struct TscCalibration {
+    bool uses_tsc = false;
+    double frequency = 0.0;
+
+    /// TSC reading and steady_clock time, in ns, at the same instant
+    std::uint64_t base_ticks = 0;
+    std::int64_t base_ns = 0;
+
+    /// Nanoseconds per tick, as a fixed-point number with NS_PER_TICK_SHIFT fractional bits
+    std::int64_t ns_per_tick = 0;
+};
+
+std::int64_t SteadyNanoseconds() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               steady_clock::now().time_since_epoch())
+        .count();
+}
+
+#if EAP_PERF_HAS_TSC
+using eap::utility::internal::int128_t;
+
+bool IsTscInvariant() noexcept {
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007) {
+        return false;
+    }
+
+    // CPUID.80000007H:EDX[8] is the invariant TSC flag on both Intel and AMD
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return (edx & (1u << 8)) != 0;
+}
+
+/**
+ * @brief Reads the TSC and steady_clock at (nearly) the same instant, by taking the TSC reading
+ *  halfway between two reads that bracket the steady_clock read.
+ *
+ * @details
+ *  The thread can be preempted inside the bracket, which would skew the midpoint, so the
+ *  narrowest of several brackets is used.
+ */
+void ReadTogether(std::uint64_t &ticks, std::int64_t &ns) noexcept {
+    constexpr int NUM_ATTEMPTS = 16;
+
+    auto narrowest = ~std::uint64_t(0);
+    for (int i = 0; i < NUM_ATTEMPTS; i++) {
+        auto const before = __rdtsc();
+        auto const attempt_ns = SteadyNanoseconds();
+        auto const after = __rdtsc();
+
+        if (after - before < narrowest) {
+            narrowest = after - before;
+            ticks = before + (after - before) / 2;
+            ns = attempt_ns;
+        }
+    }
+}
+
+TscCalibration Calibrate() noexcept {
+    TscCalibration calibration;
+    if (!IsTscInvariant()) {
+        return calibration;
+    }
+
+    std::uint64_t begin_ticks = 0, end_ticks = 0;
+    std::int64_t begin_ns = 0, end_ns = 0;
+
+    ReadTogether(begin_ticks, begin_ns);
+    auto const end = begin_ns + std::chrono::nanoseconds(CALIBRATION_TIME).count();
+    do {
+        ReadTogether(end_ticks, end_ns);
+    } while (end_ns < end);
+
+    auto const frequency =
+        static_cast<double>(end_ticks - begin_ticks) * 1e9 / static_cast<double>(end_ns - begin_ns);
+
+    // Anything outside 100 MHz - 100 GHz means the TSC can't be trusted
+    if (!(frequency > 1e8 && frequency < 1e11)) {
+        return calibration;
+    }
+
+    calibration.uses_tsc = true;
+    calibration.frequency = frequency;
+    calibration.base_ticks = end_ticks;
+    calibration.base_ns = end_ns;
+    calibration.ns_per_tick =
+        static_cast<std::int64_t>(1e9 / frequency * (std::uint64_t(1) << NS_PER_TICK_SHIFT) + 0.5);
+
+    return calibration;
+}
+#else
+TscCalibration Calibrate() noexcept { return TscCalibration(); }
+#endif
+
+TscCalibration const &GetCalibration() noexcept {
+    static TscCalibration const calibration = Calibrate();
+    return calibration;
+}
+
+#ifdef EAP_PERF_USE_TSC_CLOCK
+// Every timer reads TscClock, so calibrate before main rather than inside the first timed section
+struct CalibrateAtStartup {
+    CalibrateAtStartup() { GetCalibration(); }
+} const calibrate_at_startup;
+#endif
+} // namespace
+
+constexpr bool TscClock::is_steady;
+
+TscClock::time_point TscClock::now() noexcept {
+    auto const &calibration = GetCalibration();
+
+#if EAP_PERF_HAS_TSC
+    if (calibration.uses_tsc) {
+        auto const elapsed = static_cast<std::int64_t>(__rdtsc() - calibration.base_ticks);
+        auto const elapsed_ns = static_cast<std::int64_t>(
+            (static_cast<int128_t>(elapsed) * calibration.ns_per_tick) >> NS_PER_TICK_SHIFT);
+
+        return time_point(duration(calibration.base_ns + elapsed_ns));
+    }
+#endif
+
+    return time_point(duration(SteadyNanoseconds()));
+}
+
+bool TscClock::UsesTsc() noexcept { return GetCalibration().uses_tsc; }
+
+double TscClock::TscFrequency() noexcept { return GetCalibration().frequency; }
@@ -0,0 +1,155 @@
+#include <perf-counters.hpp>
+
+#ifdef __linux__
+#define EAP_PERF_HAS_PERF_EVENT 1
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#else
+#define EAP_PERF_HAS_PERF_EVENT 0
+#endif
+
+using eap::perf::CounterGroup;
+using eap::perf::HardwareCounters;
+using eap::perf::HardwareEvent;
+using eap::perf::NUM_HARDWARE_EVENTS;
+
+namespace {
+#if EAP_PERF_HAS_PERF_EVENT
+/// The perf_event_attr::config of each HardwareEvent
+constexpr std::uint64_t EVENT_CONFIGS[NUM_HARDWARE_EVENTS] = {PERF_COUNT_HW_CPU_CYCLES,
+                                                              PERF_COUNT_HW_INSTRUCTIONS,
+                                                              PERF_COUNT_HW_CACHE_MISSES,
+                                                              PERF_COUNT_HW_BRANCH_MISSES};
+
+/// The layout `read` fills in for PERF_FORMAT_GROUP with both total times
+struct GroupReading {
+    std::uint64_t num_events;
+    std::uint64_t time_enabled;
+    std::uint64_t time_running;
+    std::uint64_t values[NUM_HARDWARE_EVENTS];
+};
+
+/**
+ * @brief Opens a counter for `config` on the calling thread, in the group led by `group_fd`, or as
+ *  the leader of a new group if `group_fd` is -1. Returns -1 on failure.
+ */
+int OpenEvent(std::uint64_t config, int group_fd) noexcept {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.read_format =
+        PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // Counting only user space is allowed at the default kernel.perf_event_paranoid of 2
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    auto const fd = syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, PERF_FLAG_FD_CLOEXEC);
+    return static_cast<int>(fd);
+}
+
+std::uint64_t &CountOf(HardwareCounters &counters, std::size_t event) noexcept {
+    switch (static_cast<HardwareEvent>(event)) {
+    case HardwareEvent::Cycles:
+        return counters.cycles;
+    case HardwareEvent::Instructions:
+        return counters.instructions;
+    case HardwareEvent::LlcMisses:
+        return counters.llc_misses;
+    case HardwareEvent::BranchMisses:
+    default:
+        return counters.branch_misses;
+    }
+}
+#endif
+} // namespace
+
+CounterGroup &CounterGroup::Local() {
+    thread_local CounterGroup group;
+    return group;
+}
+
+CounterGroup::CounterGroup() {
+    for (auto &fd : fds_) {
+        fd = -1;
+    }
+
+#if EAP_PERF_HAS_PERF_EVENT
+    // The first event that opens leads the group
+    int leader = -1;
+    for (std::size_t i = 0; i < NUM_HARDWARE_EVENTS; i++) {
+        fds_[i] = OpenEvent(EVENT_CONFIGS[i], leader);
+        if (fds_[i] < 0) {
+            fds_[i] = -1;
+            continue;
+        }
+
+        if (leader < 0) {
+            leader = fds_[i];
+        }
+        events_ |= HardwareCounters::Bit(static_cast<HardwareEvent>(i));
+        num_open_++;
+    }
+#endif
+}
+
+CounterGroup::~CounterGroup() {
+#if EAP_PERF_HAS_PERF_EVENT
+    // Members before the leader, which is the first open event
+    for (std::size_t i = NUM_HARDWARE_EVENTS; i-- > 0;) {
+        if (fds_[i] >= 0) {
+            close(fds_[i]);
+        }
+    }
+#endif
+}
+
+HardwareCounters CounterGroup::Read() const noexcept {
+    HardwareCounters counters;
+
+#if EAP_PERF_HAS_PERF_EVENT
+    if (num_open_ == 0) {
+        return counters;
+    }
+
+    int leader = -1;
+    for (auto const fd : fds_) {
+        if (fd >= 0) {
+            leader = fd;
+            break;
+        }
+    }
+
+    GroupReading reading;
+    auto const size = sizeof(std::uint64_t) * (3 + num_open_);
+    if (read(leader, &reading, size) != static_cast<ssize_t>(size) ||
+        reading.num_events != num_open_ || reading.time_running == 0) {
+        // Never scheduled onto the processor, e.g. because other users hold the counters
+        return counters;
+    }
+
+    // Scale up for the time the group was multiplexed out
+    double const scale = reading.time_running < reading.time_enabled
+                             ? static_cast<double>(reading.time_enabled) / reading.time_running
+                             : 1.0;
+
+    // The values are in the order the events were opened
+    std::size_t value = 0;
+    for (std::size_t i = 0; i < NUM_HARDWARE_EVENTS; i++) {
+        if (fds_[i] < 0) {
+            continue;
+        }
+
+        auto const count = reading.values[value++];
+        CountOf(counters, i) =
+            scale == 1.0 ? count : static_cast<std::uint64_t>(static_cast<double>(count) * scale);
+    }
+    counters.events = events_;
+#endif
+
+    return counters;
+}
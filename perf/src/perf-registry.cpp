@@ -1,3 +1,5 @@
 #include <perf-registry.hpp>
+#include <perf-threaded_registry.hpp>
 
-template class eap::perf::TimerRegistry<eap::perf::DefaultClock>;
\ No newline at end of file
+template class eap::perf::TimerRegistry<eap::perf::DefaultClock>;
+template class eap::perf::ThreadedTimerRegistry<eap::perf::DefaultClock>;
\ No newline at end of file
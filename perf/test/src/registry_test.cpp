@@ -1,9 +1,15 @@
 #include <chrono>
+#include <perf-chrome_trace.hpp>
 #include <gtest/gtest.h>
 #include <map>
+#include <sstream>
+#include <memory>
 #include <perf-registry.hpp>
+#include <perf-threaded_registry.hpp>
 #include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 using namespace std::literals::chrono_literals;
 
@@ -85,4 +91,223 @@ TEST(EAPTimerRegistry, UnorderedSectionExit) {
             second = registry.TimeSection("second");
         },
         "Tried to pop timer 'first' while 'second' was on the top of the timer stack!");
-}
\ No newline at end of file
+}
+
+TEST(EAPTimerRegistry, CallTree) {
+    constexpr auto sleep_time = 20ms;
+
+    eap::perf::TimerRegistry<steady_clock> registry(eap::perf::TimingMode::CallTree);
+
+    for (int i = 0; i < 2; i++) {
+        auto const a = registry.TimeSection("a");
+        {
+            auto const b = registry.TimeSection("b");
+            std::this_thread::sleep_for(sleep_time);
+        }
+        {
+            auto const c = registry.TimeSection("c");
+            auto const b = registry.TimeSection("b");
+            std::this_thread::sleep_for(sleep_time);
+        }
+    }
+
+    // Every timer is timed, not only the outermost one
+    auto const &b = registry.GetTimer(registry.InsertOrLookupTimer("b"));
+    ASSERT_EQ(4, b.TimerCount());
+    ASSERT_LT(sleep_time * 4, b.SumTime());
+
+    // "b" is recorded separately under "a" and under "a" -> "c"
+    std::vector<std::pair<std::string, std::size_t>> walked;
+    registry.GetCallTree().Walk([&](std::size_t, auto const &node, std::size_t depth) {
+        walked.emplace_back(std::string(registry.GetTimerName(node.timer)), depth);
+        ASSERT_EQ(2, node.count);
+    });
+
+    std::vector<std::pair<std::string, std::size_t>> const expected{
+        {"a", 0}, {"b", 1}, {"c", 1}, {"b", 2}};
+    ASSERT_EQ(expected, walked);
+
+    auto const &tree = registry.GetCallTree();
+    auto const &a = tree.GetNode(tree.GetNode(eap::perf::CallTree<steady_clock>::ROOT).children[0]);
+    ASSERT_LT(sleep_time * 4, a.inclusive_time);
+    ASSERT_GT(sleep_time, a.ExclusiveTime());
+    ASSERT_EQ(a.inclusive_time, a.children_time + a.ExclusiveTime());
+}
+
+TEST(EAPTimerRegistry, CallTreeRecursion) {
+    eap::perf::TimerRegistry<steady_clock> registry(eap::perf::TimingMode::CallTree);
+
+    {
+        auto const outer = registry.TimeSection("recursive");
+        auto const inner = registry.TimeSection("recursive");
+    }
+
+    // The Timer only counts the outermost run, but the tree has both levels
+    ASSERT_EQ(1, registry.GetTimer(registry.InsertOrLookupTimer("recursive")).TimerCount());
+    ASSERT_EQ(3, registry.GetCallTree().Count());
+}
+
+TEST(EAPTimerRegistry, Merge) {
+    eap::perf::TimerRegistry<steady_clock> a(eap::perf::TimingMode::CallTree);
+    eap::perf::TimerRegistry<steady_clock> b(eap::perf::TimingMode::CallTree);
+
+    {
+        auto const outer = a.TimeSection("outer");
+        auto const inner = a.TimeSection("inner");
+    }
+    {
+        auto const only_b = b.TimeSection("only_b");
+    }
+    {
+        auto const outer = b.TimeSection("outer");
+        auto const inner = b.TimeSection("inner");
+    }
+
+    a.Merge(b);
+
+    ASSERT_EQ(2, a.GetTimer(a.InsertOrLookupTimer("outer")).TimerCount());
+    ASSERT_EQ(2, a.GetTimer(a.InsertOrLookupTimer("inner")).TimerCount());
+    ASSERT_EQ(1, a.GetTimer(a.InsertOrLookupTimer("only_b")).TimerCount());
+
+    // root, outer, outer/inner, only_b
+    ASSERT_EQ(4, a.GetCallTree().Count());
+}
+
+TEST(EAPThreadedTimerRegistry, Merged) {
+    constexpr size_t num_threads = 4;
+    constexpr size_t runs_per_thread = 100;
+
+    eap::perf::ThreadedTimerRegistry<steady_clock> registry;
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; t++) {
+        threads.emplace_back([&registry]() {
+            auto &local = registry.Local();
+            auto const handle = local.InsertOrLookupTimer("work");
+
+            for (size_t i = 0; i < runs_per_thread; i++) {
+                auto const section = registry.Local().TimeSection(handle);
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(num_threads, registry.NumThreads());
+
+    auto merged = registry.Merged();
+    ASSERT_EQ(num_threads * runs_per_thread,
+              merged.GetTimer(merged.InsertOrLookupTimer("work")).TimerCount());
+}
+
+TEST(EAPTimerRegistry, LookupByName) {
+    constexpr size_t num_timers = 1000;
+
+    eap::perf::TimerRegistry<steady_clock> registry;
+
+    std::vector<eap::perf::TimerHandle> handles;
+    for (size_t i = 0; i < num_timers; i++) {
+        handles.push_back(registry.InsertOrLookupTimer("timer " + std::to_string(i)));
+    }
+
+    ASSERT_EQ(num_timers, registry.Count());
+
+    for (size_t i = 0; i < num_timers; i++) {
+        auto const name = "timer " + std::to_string(i);
+        ASSERT_EQ(handles[i], registry.InsertOrLookupTimer(string_view(name)));
+        ASSERT_EQ(string_view(name), registry.GetTimerName(handles[i]));
+    }
+
+    // A copy has its own names, so it must still find them once the original is gone
+    auto copy = std::make_unique<eap::perf::TimerRegistry<steady_clock>>(registry);
+    registry = eap::perf::TimerRegistry<steady_clock>();
+
+    ASSERT_EQ(handles[42], copy->InsertOrLookupTimer("timer 42"));
+    ASSERT_EQ(num_timers, copy->Count());
+}
+
+TEST(EAPTimerRegistry, Trace) {
+    eap::perf::TimerRegistry<steady_clock> registry;
+    registry.EnableTracing(4);
+
+    for (int i = 0; i < 2; i++) {
+        auto const outer = registry.TimeSection("outer");
+        auto const inner = registry.TimeSection("in\"ner");
+    }
+
+    // Nested runs are traced too, inner before outer since events are recorded when they end
+    auto const &trace = registry.GetTrace();
+    ASSERT_EQ(4u, trace.Size());
+    ASSERT_EQ(0u, trace.NumOverwritten());
+
+    std::vector<std::size_t> timers;
+    trace.ForEach([&](eap::perf::TraceEvent const &event) {
+        ASSERT_LE(event.begin, event.end);
+        timers.push_back(event.timer);
+    });
+    ASSERT_EQ((std::vector<std::size_t>{1, 0, 1, 0}), timers);
+
+    // A full buffer keeps the most recent events
+    {
+        auto const last = registry.TimeSection("last");
+    }
+    ASSERT_EQ(4u, trace.Size());
+    ASSERT_EQ(1u, trace.NumOverwritten());
+
+    std::stringstream json;
+    eap::perf::WriteChromeTrace(json, registry, 3);
+
+    auto const text = json.str();
+    ASSERT_EQ(0u, text.find("{\"traceEvents\":[\n{\"name\":\"outer\",\"ph\":\"X\""));
+    ASSERT_NE(std::string::npos, text.find("\"name\":\"in\\\"ner\""));
+    ASSERT_NE(std::string::npos, text.find("\"name\":\"last\""));
+    ASSERT_NE(std::string::npos, text.find("\"pid\":3"));
+    ASSERT_NE(std::string::npos, text.find("\"overwritten_events\":1"));
+}
+
+TEST(EAPThreadedTimerRegistry, MergedTrace) {
+    eap::perf::ThreadedTimerRegistry<steady_clock> registry;
+    registry.EnableTracing(16);
+
+    std::thread thread(
+        [&registry]() { auto const section = registry.Local().TimeSection("thread"); });
+    thread.join();
+    {
+        auto const section = registry.Local().TimeSection("main");
+    }
+
+    auto const merged = registry.Merged();
+    ASSERT_EQ(2u, merged.GetTrace().Size());
+
+    std::vector<std::uint32_t> threads;
+    merged.GetTrace().ForEach(
+        [&](eap::perf::TraceEvent const &event) { threads.push_back(event.thread); });
+    ASSERT_NE(threads[0], threads[1]);
+}
+
+TEST(EAPTimerRegistry, MergeOverwrittenTrace) {
+    eap::perf::TimerRegistry<steady_clock> overflowed;
+    overflowed.EnableTracing(2);
+    for (int i = 0; i < 5; i++) {
+        auto const section = overflowed.TimeSection("overflowed");
+    }
+    ASSERT_EQ(3u, overflowed.GetTrace().NumOverwritten());
+
+    eap::perf::TimerRegistry<steady_clock> registry;
+    registry.EnableTracing(1);
+    for (int i = 0; i < 2; i++) {
+        auto const section = registry.TimeSection("registry");
+    }
+    ASSERT_EQ(1u, registry.GetTrace().NumOverwritten());
+
+    // The merged trace holds every held event, and counts the events lost by both registries
+    registry.Merge(overflowed);
+    ASSERT_EQ(3u, registry.GetTrace().Size());
+    ASSERT_EQ(4u, registry.GetTrace().NumOverwritten());
+
+    std::stringstream json;
+    eap::perf::WriteChromeTrace(json, registry, 0);
+    ASSERT_NE(std::string::npos, json.str().find("\"overwritten_events\":4"));
+}
@@ -1,5 +1,8 @@
 #include <chrono>
 #include <gtest/gtest.h>
+#include <perf-clock.hpp>
+#include <perf-counters.hpp>
+#include <perf-histogram.hpp>
 #include <perf-timer.hpp>
 #include <thread>
 
@@ -60,4 +63,164 @@ TEST(EAPTimer, ThrowOnStartWhileRunning) {
 TEST(EAPTimer, ThrowOnStopWhileStopped) {
     eap::perf::Timer<> timer;
     ASSERT_THROW(timer.Stop(), eap::perf::TimerNotRunningException);
-}
\ No newline at end of file
+}
+
+TEST(EAPTimer, Percentiles) {
+    eap::perf::Timer<> timer;
+
+    timer.Start();
+    timer.Stop();
+    ASSERT_FALSE(timer.Percentile(50));
+
+    timer.EnableHistogram();
+    for (auto i = 0; i < 10; i++) {
+        timer.Start();
+        std::this_thread::sleep_for(1ms);
+        timer.Stop();
+    }
+
+    ASSERT_EQ(10u, timer.GetHistogram()->TotalCount());
+    ASSERT_LE(1ms, timer.Percentile(50).value());
+    ASSERT_LE(timer.Percentile(50).value(), timer.Percentile(99.9).value());
+    ASSERT_EQ(timer.MaxTime(), timer.Percentile(100));
+}
+
+TEST(EAPDurationHistogram, Percentiles) {
+    using Histogram = eap::perf::DurationHistogram<std::chrono::nanoseconds>;
+
+    Histogram histogram;
+    ASSERT_FALSE(histogram.Percentile(50));
+
+    for (auto i = 1; i <= 1000; i++) {
+        histogram.Record(std::chrono::nanoseconds(i));
+    }
+
+    // Never below the true percentile, and within a bucket's width above it
+    auto const check = [&](double percentile, double expected) {
+        auto const estimate = static_cast<double>(histogram.Percentile(percentile).value().count());
+        ASSERT_LE(expected, estimate);
+        ASSERT_GE(expected * (1.0 + 1.0 / Histogram::SUB_BUCKETS), estimate);
+    };
+
+    check(50, 500);
+    check(90, 900);
+    check(99, 990);
+    check(99.9, 999);
+
+    // Small durations are exact
+    Histogram small;
+    small.Record(std::chrono::nanoseconds(3));
+    small.Record(std::chrono::nanoseconds(-1));
+    ASSERT_EQ(std::chrono::nanoseconds(0), small.Percentile(50));
+    ASSERT_EQ(std::chrono::nanoseconds(3), small.Percentile(100));
+
+    small.Merge(histogram);
+    ASSERT_EQ(1002u, small.TotalCount());
+}
+
+TEST(EAPTscClock, MatchesSteadyClock) {
+    using eap::perf::TscClock;
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+    using std::chrono::steady_clock;
+
+    if (TscClock::UsesTsc()) {
+        ASSERT_GT(TscClock::TscFrequency(), 0.0);
+    } else {
+        ASSERT_EQ(0.0, TscClock::TscFrequency());
+    }
+
+    // Shares steady_clock's epoch
+    auto const steady_now = duration_cast<nanoseconds>(steady_clock::now().time_since_epoch());
+    auto const tsc_now = TscClock::now().time_since_epoch();
+    auto const offset = tsc_now > steady_now ? tsc_now - steady_now : steady_now - tsc_now;
+    ASSERT_LT(offset, 10ms);
+
+    auto previous = TscClock::now();
+    for (int i = 0; i < 10000; i++) {
+        auto const now = TscClock::now();
+        ASSERT_LE(previous, now);
+        previous = now;
+    }
+
+    constexpr auto sleep_time = 50ms;
+
+    eap::perf::Timer<TscClock> timer;
+    auto const steady_begin = steady_clock::now();
+    timer.Start();
+    std::this_thread::sleep_for(sleep_time);
+    timer.Stop();
+    auto const steady_time = steady_clock::now() - steady_begin;
+
+    ASSERT_LE(sleep_time, timer.SumTime());
+    ASSERT_GE(steady_time + 1ms, timer.SumTime());
+}
+
+TEST(EAPTimer, HardwareCounters) {
+    using eap::perf::HardwareEvent;
+
+    eap::perf::Timer<> timer;
+    ASSERT_EQ(nullptr, timer.GetCounters());
+
+    timer.EnableCounters();
+    volatile std::uint64_t sum = 0;
+    for (auto i = 0; i < 4; i++) {
+        timer.Start();
+        for (std::uint64_t j = 0; j < 100000; j++) {
+            sum = sum + j;
+        }
+        timer.Stop();
+    }
+
+    // Runs are counted even if this machine has no counters
+    auto const &counters = *timer.GetCounters();
+    ASSERT_EQ(4u, counters.runs);
+    ASSERT_EQ(eap::perf::CounterGroup::Local().Events(), counters.events);
+
+    if (counters.Counted(HardwareEvent::Instructions)) {
+        ASSERT_LE(100000u, counters.instructions);
+    }
+    if (counters.Counted(HardwareEvent::Cycles) && counters.Counted(HardwareEvent::Instructions)) {
+        ASSERT_LT(0.0, counters.Ipc().value());
+    } else {
+        ASSERT_FALSE(counters.Ipc());
+    }
+
+    eap::perf::Timer<> merged;
+    merged.Merge(timer);
+    merged.Merge(timer);
+    ASSERT_EQ(8u, merged.GetCounters()->runs);
+    ASSERT_EQ(2 * counters.instructions, merged.GetCounters()->instructions);
+}
+
+TEST(EAPHardwareCounters, DerivedMetrics) {
+    using eap::perf::HardwareCounters;
+    using eap::perf::HardwareEvent;
+
+    HardwareCounters start;
+    start.events = HardwareCounters::Bit(HardwareEvent::Cycles) |
+                   HardwareCounters::Bit(HardwareEvent::Instructions) |
+                   HardwareCounters::Bit(HardwareEvent::BranchMisses);
+    start.cycles = 100;
+    start.instructions = 1000;
+
+    auto end = start;
+    end.cycles += 1000;
+    end.instructions += 2000;
+    end.branch_misses += 10;
+
+    HardwareCounters counters;
+    counters.AddRun(start, end);
+    ASSERT_EQ(1u, counters.runs);
+    ASSERT_DOUBLE_EQ(2.0, counters.Ipc().value());
+    ASSERT_DOUBLE_EQ(5.0, counters.BranchMissesPerKiloInstruction().value());
+    // Not counted, so not reported as 0
+    ASSERT_FALSE(counters.LlcMissesPerKiloInstruction());
+
+    // An event missing from any run is dropped
+    HardwareCounters no_events;
+    no_events.runs = 1;
+    counters += no_events;
+    ASSERT_EQ(2u, counters.runs);
+    ASSERT_FALSE(counters.Ipc());
+}
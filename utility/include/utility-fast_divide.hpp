@@ -0,0 +1,102 @@
+/**
+ * @file utility-fast_divide.hpp
+ *
+ * @brief Division of unsigned integers by a runtime-invariant divisor using a precomputed
+ * multiplier.
+ * @date 2019-09-12
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+#ifndef EAP_UTILITY_FAST_DIVIDE_HPP_
+#define EAP_UTILITY_FAST_DIVIDE_HPP_
+
+// STL Includes
+#include <cstdint>
+#include <stdexcept>
+
+// Third Party Includes
+#include <Kokkos_Core.hpp>
+
+namespace eap {
+namespace utility {
+namespace internal {
+/// GCC/Clang extensions, which `__extension__` keeps quiet under -pedantic
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
+} // namespace internal
+
+/**
+ * @brief Divides 64-bit unsigned integers by a fixed divisor with a multiply and shifts.
+ *
+ * @details
+ *  Integer division is one of the slowest integer instructions on both CPUs and GPUs, and
+ *  compilers can only replace it with a multiplication when the divisor is a compile-time
+ *  constant. FastDivisor computes the same "magic number" once at runtime, following
+ *  T. Granlund and P. Montgomery, "Division by Invariant Integers using Multiplication" (1994),
+ *  the algorithm also used by libdivide. Every quotient in [0, 2^64) is exact.
+ */
+class FastDivisor {
+  public:
+    /**
+     * @brief Builds a divisor of 1
+     */
+    constexpr FastDivisor() noexcept = default;
+
+    /**
+     * @brief Precomputes the multiplier for dividing by `divisor`. Must be > 0.
+     */
+    explicit FastDivisor(std::uint64_t divisor) : divisor_(divisor) {
+        if (divisor == 0) {
+            throw std::invalid_argument("FastDivisor cannot divide by zero.");
+        }
+
+        // l = ceil(log2(divisor))
+        unsigned l = 0;
+        while (l < 64 && (std::uint64_t(1) << l) < divisor) {
+            l++;
+        }
+
+        // magic = floor(2^64 * (2^l - divisor) / divisor) + 1, which always fits in 64 bits
+        using internal::uint128_t;
+        auto const numerator = ((uint128_t(1) << l) - divisor) << 64;
+        magic_ = static_cast<std::uint64_t>(numerator / divisor) + 1;
+
+        shift1_ = l < 1 ? l : 1;
+        shift2_ = l < 1 ? 0 : l - 1;
+    }
+
+    /** @brief The divisor */
+    KOKKOS_FORCEINLINE_FUNCTION std::uint64_t divisor() const noexcept { return divisor_; }
+
+    /** @brief Returns `n / divisor()` */
+    KOKKOS_FORCEINLINE_FUNCTION std::uint64_t Divide(std::uint64_t n) const noexcept {
+        auto const t = MultiplyHigh(magic_, n);
+        return (t + ((n - t) >> shift1_)) >> shift2_;
+    }
+
+    /** @brief Returns `n % divisor()` */
+    KOKKOS_FORCEINLINE_FUNCTION std::uint64_t Modulo(std::uint64_t n) const noexcept {
+        return n - Divide(n) * divisor_;
+    }
+
+  private:
+    /** @brief Returns the upper 64 bits of the 128-bit product `a * b` */
+    KOKKOS_FORCEINLINE_FUNCTION static std::uint64_t MultiplyHigh(std::uint64_t a,
+                                                                  std::uint64_t b) noexcept {
+#ifdef __CUDA_ARCH__
+        return __umul64hi(a, b);
+#else
+        return static_cast<std::uint64_t>((static_cast<internal::uint128_t>(a) * b) >> 64);
+#endif
+    }
+
+    std::uint64_t divisor_ = 1;
+    std::uint64_t magic_ = 1;
+    unsigned shift1_ = 0;
+    unsigned shift2_ = 0;
+};
+} // namespace utility
+} // namespace eap
+
+#endif // EAP_UTILITY_FAST_DIVIDE_HPP_
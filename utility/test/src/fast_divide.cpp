@@ -0,0 +1,44 @@
+/**
+ * @file fast_divide.cpp
+ *
+ * @brief Tests for FastDivisor
+ * @date 2019-09-12
+ *
+ * @copyright Copyright (C) 2019 Triad National Security, LLC
+ */
+
+// STL Includes
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Third Party Includes
+#include <gtest/gtest.h>
+
+// Internal Includes
+#include <utility-fast_divide.hpp>
+
+using eap::utility::FastDivisor;
+
+TEST(FastDivisor, MatchesDivision) {
+    constexpr auto max = std::numeric_limits<std::uint64_t>::max();
+
+    std::vector<std::uint64_t> divisors{max, max - 1, std::uint64_t(1) << 63,
+                                        (std::uint64_t(1) << 63) + 1, (std::uint64_t(1) << 32) + 1};
+    for (std::uint64_t d = 1; d < 1000; d++) {
+        divisors.push_back(d);
+    }
+
+    for (auto const d : divisors) {
+        FastDivisor const divisor(d);
+        ASSERT_EQ(d, divisor.divisor());
+
+        for (auto const n : {std::uint64_t(0), std::uint64_t(1), d - 1, d, d + 1, 3 * d + 2,
+                             max / 2, max - 1, max}) {
+            ASSERT_EQ(n / d, divisor.Divide(n)) << n << " / " << d;
+            ASSERT_EQ(n % d, divisor.Modulo(n)) << n << " % " << d;
+        }
+    }
+}
+
+TEST(FastDivisor, Zero) { ASSERT_THROW(FastDivisor(0), std::invalid_argument); }